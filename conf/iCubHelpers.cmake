@@ -399,6 +399,24 @@ macro(icub_app_all)
     add_dependencies(install_applications ${applications})
 endmacro(icub_app_all)
 
+##
+# Declare a unit test, built and registered with ctest only when
+# ICUB_COMPILE_TESTS is enabled.
+#
+# icub_add_test(name
+#               SOURCES file1 file2 ...
+#               [LINK lib1 lib2 ...])
+macro(icub_add_test name)
+    if (ICUB_COMPILE_TESTS)
+        PARSE_ARGUMENTS(_icub_test "SOURCES;LINK" "" ${ARGN})
+        add_executable(${name} ${_icub_test_SOURCES})
+        if (_icub_test_LINK)
+            target_link_libraries(${name} ${_icub_test_LINK})
+        endif (_icub_test_LINK)
+        add_test(NAME ${name} COMMAND ${name})
+    endif (ICUB_COMPILE_TESTS)
+endmacro(icub_add_test)
+
 ### From yarp.
 # Helper macro to work around a bug in set_property in cmake 2.6.0
 # We use icub_ prefix to avoid name clashes with yarp.
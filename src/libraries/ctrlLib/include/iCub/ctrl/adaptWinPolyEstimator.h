@@ -92,6 +92,9 @@ protected:
     yarp::sig::Vector winLen;
     yarp::sig::Vector mse;
 
+    yarp::sig::Vector tMom;
+    yarp::sig::Vector yMom;
+
     bool firstRun;
 
     /**
@@ -105,6 +108,19 @@ protected:
     virtual yarp::sig::Vector fit(const yarp::sig::Vector &x,
                                   const yarp::sig::Vector &y, const unsigned int n=0);
 
+    /**
+    * Find the regressor which best fits in least square sense the 
+    * last n data sample couples relying on the running moments of 
+    * the window (closed form, available for order<=2). 
+    * @param n last n data sample couples to fit.
+    * @return true if the coefficients have been computed, false if 
+    *         the general fit() is to be used instead.
+    * @note tMom holds the moments sum(t^k), k=0..2*order, of all 
+    *       the trailing windows, whereas yMom holds the moments
+    *       sum(x*t^k), k=0..order, of the last n couples.
+    */
+    virtual bool fitMoments(const unsigned int n);
+
     /** 
     * Evaluate regressor at certain point. 
     * @param x the point.
@@ -54,8 +54,12 @@ protected:
    yarp::sig::Vector a;
    yarp::sig::Vector y;
 
-   std::deque<yarp::sig::Vector> uold;
-   std::deque<yarp::sig::Vector> yold;
+   // ring buffers of the past inputs and outputs: (m-1) and (n-1)
+   // rows respectively, each one holding all the channels
+   yarp::sig::Vector uold;
+   yarp::sig::Vector yold;
+   size_t uhead;
+   size_t yhead;
    size_t n;
    size_t m;
 
@@ -286,12 +290,17 @@ public:
 class MedianFilter
 {
 protected:
-   std::deque<std::deque<double> > uold;
+   // for each channel, the last n+1 samples in arrival order
+   // (ring buffer) and the same samples kept sorted
+   yarp::sig::Vector uold;
+   yarp::sig::Vector usorted;
+   size_t head;
+   size_t cnt;
    yarp::sig::Vector y;
    size_t n;
    size_t m;
 
-   double median(std::deque<double>& v);
+   double median(const double *v, const size_t len);
 
 public:
    /**
@@ -41,6 +41,13 @@ AWPolyEstimator::AWPolyEstimator(unsigned int _order, unsigned int _N, const dou
     t.resize(N);
     x.resize(N);
 
+    // moments of the trailing windows for the closed-form fitting
+    if (order<=2)
+    {
+        tMom.resize((2*order+1)*(N+1),0.0);
+        yMom.resize(order+1,0.0);
+    }
+
     firstRun=true;
 }
 
@@ -98,6 +105,57 @@ Vector AWPolyEstimator::fit(const Vector &x, const Vector &y, const unsigned int
 }
 
 
+/***************************************************************************/
+bool AWPolyEstimator::fitMoments(const unsigned int n)
+{
+    if (order>2)
+        return false;
+
+    const double *m=tMom.data()+(2*order+1)*n;
+    const double *b=yMom.data();
+
+    if (order==1)
+    {
+        double den=m[0]*m[2]-m[1]*m[1];
+
+        // coincident time stamps: the slope cannot be observed
+        if (!(fabs(den)>1e-12*m[0]*m[2]))
+        {
+            coeff[0]=b[0]/m[0];
+            coeff[1]=0.0;
+            return true;
+        }
+
+        // the bias
+        coeff[0]=(b[0]*m[2]-m[1]*b[1]) / den;
+
+        // the linear coefficient
+        coeff[1]=(m[0]*b[1]-m[1]*b[0]) / den;
+    }
+    else
+    {
+        // solve the 3x3 normal equations through the adjugate
+        double c00=m[2]*m[4]-m[3]*m[3];
+        double c01=m[2]*m[3]-m[1]*m[4];
+        double c02=m[1]*m[3]-m[2]*m[2];
+        double c11=m[0]*m[4]-m[2]*m[2];
+        double c12=m[1]*m[2]-m[0]*m[3];
+        double c22=m[0]*m[2]-m[1]*m[1];
+        double det=m[0]*c00+m[1]*c01+m[2]*c02;
+
+        // let pinv() deal with ill-conditioned windows
+        if (!(fabs(det)>1e-12*m[0]*m[2]*m[4]))
+            return false;
+
+        coeff[0]=(c00*b[0]+c01*b[1]+c02*b[2]) / det;
+        coeff[1]=(c01*b[0]+c11*b[1]+c12*b[2]) / det;
+        coeff[2]=(c02*b[0]+c12*b[1]+c22*b[2]) / det;
+    }
+
+    return true;
+}
+
+
 /***************************************************************************/
 void AWPolyEstimator::feedData(const AWPolyElement &el)
 {
@@ -127,9 +185,31 @@ Vector AWPolyEstimator::estimate()
         return esteem=0.0;
 
     // retrieve the time vector
-    // starting from t=0 (numeric stability reason)
+    // relative to the newest sample, which is shared by all
+    // the trailing windows (numeric stability reason)
     for (unsigned int j=0; j<N; j++)
-        t[j]=elemList[delta+j].time-elemList[delta].time;
+        t[j]=elemList[delta+j].time-elemList[L-1].time;
+
+    // the time moments of all the trailing windows
+    // are shared by all the elements
+    bool moments=(order<=2);
+    unsigned int K=2*order+1;
+    if (moments)
+    {
+        for (unsigned int k=0; k<K; k++)
+            tMom[k]=0.0;
+
+        for (unsigned int n=1; n<=N; n++)
+        {
+            double _t=t[N-n];
+            double tk=1.0;
+            for (unsigned int k=0; k<K; k++)
+            {
+                tMom[K*n+k]=tMom[K*(n-1)+k]+tk;
+                tk*=_t;
+            }
+        }
+    }
 
     // cycle upon all elements
     for (unsigned int i=0; i<dim; i++)
@@ -142,11 +222,41 @@ Vector AWPolyEstimator::estimate()
         unsigned int n1=(unsigned int)((winLen[i]>(order+1))?(winLen[i]-1):(order+1));
         unsigned int n2=(unsigned int)((winLen[i]<N)?(winLen[i]+1):N);
 
+        // data moments of the last n1-1 couples:
+        // they are then grown by one couple per window's length
+        if (moments)
+        {
+            for (unsigned int k=0; k<=order; k++)
+                yMom[k]=0.0;
+
+            for (unsigned int j=N-n1+1; j<N; j++)
+            {
+                double yk=x[j];
+                for (unsigned int k=0; k<=order; k++)
+                {
+                    yMom[k]+=yk;
+                    yk*=t[j];
+                }
+            }
+        }
+
         // cycle upon all possibile window's length
         for (unsigned int n=n1; n<=n2; n++)
         {
             // find the regressor's coefficients
-            coeff=fit(t,x,n);
+            if (moments)
+            {
+                double yk=x[N-n];
+                for (unsigned int k=0; k<=order; k++)
+                {
+                    yMom[k]+=yk;
+                    yk*=t[N-n];
+                }
+            }
+
+            if (!moments || !fitMoments(n))
+                coeff=fit(t,x,n);
+
             bool _stop=false;            
 
             // test the regressor upon all the elements
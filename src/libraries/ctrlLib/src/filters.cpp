@@ -39,9 +39,6 @@ Filter::Filter(const Vector &num, const Vector &den, const Vector &y0)
     m=b.length(); n=a.length();
     yAssert((m>0)&&(n>0));
 
-    uold.insert(uold.begin(),m-1,zeros(y0.length()));
-    yold.insert(yold.begin(),n-1,zeros(y0.length()));
-
     init(y0);    
 }
 
@@ -51,8 +48,15 @@ void Filter::init(const Vector &y0)
 {
     // take the last input
     // as guess for the next input
-    if (uold.size()>0)
-        init(y0,uold[0]);
+    if ((m>1) && (uold.length()>0))
+    {
+        size_t L=uold.length()/(m-1);
+        Vector u0(L);
+        for (size_t j=0; j<L; j++)
+            u0[j]=uold[uhead*L+j];
+
+        init(y0,u0);
+    }
     else    // otherwise use zero
         init(y0,zeros(y0.length()));    
 }
@@ -87,11 +91,19 @@ void Filter::init(const Vector &y0, const Vector &u0)
         // if sum_a==a[0] then the filter can only be initialized to zero
     }
     
-    for (size_t i=0; i<yold.size(); i++)
-        yold[i]=y_init;
+    size_t L=y.length();
+
+    yold.resize((n-1)*L);
+    for (size_t i=0; i<n-1; i++)
+        for (size_t j=0; j<L; j++)
+            yold[i*L+j]=y_init[j];
     
-    for (size_t i=0; i<uold.size(); i++)
-        uold[i]=u_init;
+    uold.resize((m-1)*L);
+    for (size_t i=0; i<m-1; i++)
+        for (size_t j=0; j<L; j++)
+            uold[i*L+j]=u_init[j];
+
+    uhead=yhead=0;
 }
 
 
@@ -115,9 +127,6 @@ void Filter::setCoeffs(const Vector &num, const Vector &den)
     m=b.length(); n=a.length();
     yAssert((m>0)&&(n>0));
 
-    uold.insert(uold.begin(),m-1,zeros(y.length()));
-    yold.insert(yold.begin(),n-1,zeros(y.length()));
-
     init(y);
 }
 
@@ -139,8 +148,17 @@ bool Filter::adjustCoeffs(const Vector &num, const Vector &den)
 /***************************************************************************/
 void Filter::getStates(deque<Vector> &u, deque<Vector> &y)
 {
-    u=uold;
-    y=yold;
+    size_t L=this->y.length();
+
+    u.assign(m-1,Vector(L));
+    for (size_t i=0; i<m-1; i++)
+        for (size_t j=0; j<L; j++)
+            u[i][j]=uold[((uhead+i)%(m-1))*L+j];
+
+    y.assign(n-1,Vector(L));
+    for (size_t i=0; i<n-1; i++)
+        for (size_t j=0; j<L; j++)
+            y[i][j]=yold[((yhead+i)%(n-1))*L+j];
 }
 
 
@@ -148,25 +166,51 @@ void Filter::getStates(deque<Vector> &u, deque<Vector> &y)
 const Vector& Filter::filt(const Vector &u)
 {
     yAssert(y.length()==u.length());
-    for (size_t j=0; j<y.length(); j++)
-        y[j]=b[0]*u[j];
+    size_t L=y.length();
+    double *_y=y.data();
+    const double *_u=u.data();
+
+    // the channels are contiguous within each row
+    // of the states, so the inner loops are plain
+    // streams over the channels
+    for (size_t j=0; j<L; j++)
+        _y[j]=b[0]*_u[j];
     
     for (size_t i=1; i<m; i++)
-        for (size_t j=0; j<y.length(); j++)
-            y[j]+=b[i]*uold[i-1][j];
+    {
+        const double  bi=b[i];
+        const double *_uold=uold.data()+((uhead+i-1)%(m-1))*L;
+        for (size_t j=0; j<L; j++)
+            _y[j]+=bi*_uold[j];
+    }
     
     for (size_t i=1; i<n; i++)
-        for (size_t j=0; j<y.length(); j++)
-            y[j]-=a[i]*yold[i-1][j];
-    
-    for (size_t j=0; j<y.length(); j++)
-        y[j]/=a[0];
+    {
+        const double  ai=a[i];
+        const double *_yold=yold.data()+((yhead+i-1)%(n-1))*L;
+        for (size_t j=0; j<L; j++)
+            _y[j]-=ai*_yold[j];
+    }
     
-    uold.push_front(u);
-    uold.pop_back();
+    for (size_t j=0; j<L; j++)
+        _y[j]/=a[0];
     
-    yold.push_front(y);
-    yold.pop_back();
+    // the oldest row is overwritten by the newest sample
+    if (m>1)
+    {
+        uhead=(uhead+m-2)%(m-1);
+        double *_uold=uold.data()+uhead*L;
+        for (size_t j=0; j<L; j++)
+            _uold[j]=_u[j];
+    }
+
+    if (n>1)
+    {
+        yhead=(yhead+n-2)%(n-1);
+        double *_yold=yold.data()+yhead*L;
+        for (size_t j=0; j<L; j++)
+            _yold[j]=_y[j];
+    }
     
     return y;
 }
@@ -314,7 +358,13 @@ void MedianFilter::init(const Vector &y0)
     yAssert(y0.length()>0);
     y=y0;
     m=y.length();
-    uold.assign(m,deque<double>());
+
+    // each channel holds up to n+1 samples,
+    // both in arrival order and sorted
+    uold.resize(m*(n+1));
+    usorted.resize(m*(n+1));
+    head=0;
+    cnt=0;
 }
 
 
@@ -328,17 +378,13 @@ void MedianFilter::setOrder(const size_t n)
 
 
 /***************************************************************************/
-double MedianFilter::median(deque<double>& v)
+double MedianFilter::median(const double *v, const size_t len)
 {
-    size_t L=v.size()>>1;
-    nth_element(v.begin(),v.begin()+L,v.end());
-    if (v.size()&0x01)
+    size_t L=len>>1;
+    if (len&0x01)
         return v[L];
     else
-    {
-        nth_element(v.begin(),v.begin()+L-1,v.end());
         return 0.5*(v[L]+v[L-1]);
-    }
 }
 
 
@@ -346,20 +392,38 @@ double MedianFilter::median(deque<double>& v)
 const Vector& MedianFilter::filt(const Vector &u)
 {
     yAssert(y.length()==u.length());
+    size_t N=n+1;
+    size_t tail=(head+cnt)%N;
+
+    // insert the new sample in the sorted window
+    // (binary search plus a short shift of contiguous memory)
     for (size_t i=0; i<m; i++)
-        uold[i].push_front(u[i]);
+    {
+        double *s=usorted.data()+i*N;
+        double *pos=upper_bound(s,s+cnt,u[i]);
+        copy_backward(pos,s+cnt,s+cnt+1);
+        *pos=u[i];
+
+        uold[i*N+tail]=u[i];
+    }
+    cnt++;
 
-    if (uold[0].size()>n)
+    if (cnt>n)
     {
         for (size_t i=0; i<m; i++)
         {
-            deque<double> tmp=uold[i];
-            y[i]=median(tmp);
-            uold[i].pop_back();
+            double *s=usorted.data()+i*N;
+            y[i]=median(s,cnt);
+
+            // drop the oldest sample from the sorted window
+            double *pos=lower_bound(s,s+cnt,uold[i*N+head]);
+            copy(pos+1,s+cnt,pos);
         }
+
+        head=(head+1)%N;
+        cnt--;
     }
 
     return y;
 }
 
-
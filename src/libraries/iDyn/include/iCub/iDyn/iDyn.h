@@ -72,6 +72,7 @@
 #include <iCub/iDyn/iDynInv.h>
 
 #include <deque>
+#include <vector>
 #include <string>
 
 
@@ -524,6 +525,28 @@ public:
 
 
 
+/**
+* \ingroup iDyn
+*
+* The spatial (6D, angular part first) description of a link used 
+* by the recursive algorithms of iDynChain, expressed in the link 
+* frame at its origin. 
+*/
+struct SpatialLink
+{
+    /// rotation from the parent frame to the link frame
+    double E[9];
+    /// origin of the link frame in the parent frame
+    double r[3];
+    /// motion subspace of the joint
+    double S[6];
+    /// spatial inertia at the link origin
+    double I[36];
+    /// false if the link is blocked
+    bool   active;
+};
+
+
 /**
 * \ingroup iDyn
 *
@@ -555,6 +578,16 @@ protected:
 
     const yarp::sig::Vector zero0;
 
+    /// spatial description of the links and workspace of the recursive algorithms
+    std::vector<SpatialLink> spatialLinks;
+    std::vector<double>      spatialWork;
+    std::vector<int>         spatialDof;
+
+    /**
+    * Fills spatialLinks with the current configuration of the links
+    */
+    void computeSpatialLinks();
+
     /**
     * Clone function
     */
@@ -1093,6 +1126,8 @@ public:
 
     /**
     * Compute the joint space mass matrix considering only the active joints.
+    * The Composite Rigid Body Algorithm is used, the joint velocities and 
+    * accelerations are left untouched.
     * @return a DOF-by-DOF symmetric positive-definite matrix
     */
     yarp::sig::Matrix computeMassMatrix();
@@ -1153,6 +1188,30 @@ public:
     */
     yarp::sig::Vector computeCcGravityTorques(const yarp::sig::Vector& ddp0, const yarp::sig::Vector& q, const yarp::sig::Vector& dq);
 
+    /**
+    * Compute the joint accelerations produced by the given joint torques, considering only
+    * the active joints and no gravity (Articulated Body Algorithm).
+    * @param q vector of the active joint positions
+    * @param dq vector of the active joint velocities
+    * @param tau vector of the active joint torques
+    * @return a DOF-dim vector with the joint accelerations
+    * @note q and dq are set in the chain as in computeCcTorques(), the joint accelerations are not.
+    */
+    yarp::sig::Vector computeForwardDynamics(const yarp::sig::Vector& q, const yarp::sig::Vector& dq, const yarp::sig::Vector& tau);
+
+    /**
+    * Compute the joint accelerations produced by the given joint torques and by gravity, 
+    * considering only the active joints (Articulated Body Algorithm).
+    * @param q vector of the active joint positions
+    * @param dq vector of the active joint velocities
+    * @param tau vector of the active joint torques
+    * @param ddp0 a vector that is equal and opposite to gravity expressed in the base reference frame (not the 0th frame)
+    * @return a DOF-dim vector with the joint accelerations
+    * @note q and dq are set in the chain as in computeCcTorques(), the joint accelerations are not.
+    */
+    yarp::sig::Vector computeForwardDynamics(const yarp::sig::Vector& q, const yarp::sig::Vector& dq, const yarp::sig::Vector& tau,
+                                             const yarp::sig::Vector& ddp0);
+
 
 
 };
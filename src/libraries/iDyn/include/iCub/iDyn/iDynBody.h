@@ -46,6 +46,8 @@
 #ifndef __IDYNBODY_H__
 #define __IDYNBODY_H__
 
+#include <yarp/os/Thread.h>
+#include <yarp/os/Semaphore.h>
 #include <yarp/sig/Vector.h>
 #include <yarp/sig/Matrix.h>
 #include <iCub/ctrl/math.h>
@@ -53,6 +55,7 @@
 #include <iCub/iDyn/iDynInv.h>
 #include <iCub/iDyn/iDynContact.h>
 #include <deque>
+#include <vector>
 #include <string>
 
 
@@ -510,6 +513,90 @@ public:
 };
 
 
+class iDynNodeWorker;
+class iDynNodePhase;
+
+/**
+* \ingroup iDynBody
+*
+* A job which can be dispatched by iDynNodeWorkerPool: exec() is
+* called once for each index of the job.
+*/
+class iDynNodeTask
+{
+public:
+    /**
+    * Executes the i-th item of the job.
+    * @param i the index of the item
+    */
+    virtual void exec(const unsigned int i)=0;
+
+    /**
+    * Destructor.
+    */
+    virtual ~iDynNodeTask() { }
+};
+
+
+/**
+* \ingroup iDynBody
+*
+* A small pool of persistent threads used by iDynNode to propagate
+* kinematics and wrenches along independent limbs concurrently. The
+* threads are created once and are woken up at each dispatch, so that
+* no thread is spawned within the control loop. The same pool can be
+* shared by several nodes, as long as they are solved one at a time.
+*/
+class iDynNodeWorkerPool
+{
+private:
+    // prevent copies
+    iDynNodeWorkerPool(const iDynNodeWorkerPool&);
+    iDynNodeWorkerPool &operator=(const iDynNodeWorkerPool&);
+
+protected:
+    std::vector<iDynNodeWorker*> workers;
+    yarp::os::Semaphore done;
+
+    iDynNodeTask *task;
+    unsigned int  n;
+    unsigned int  stride;
+
+    void execShare(const unsigned int id);
+
+    friend class iDynNodeWorker;
+
+public:
+    /**
+    * Constructor.
+    * @param nThreads the number of threads of the pool. The caller
+    *                 of run() takes part to the computation as well,
+    *                 thus nThreads=0 yields a sequential execution.
+    */
+    iDynNodeWorkerPool(const unsigned int nThreads);
+
+    /**
+    * Returns the number of threads of the pool.
+    * @return the number of threads.
+    */
+    unsigned int getNumThreads() const { return (unsigned int)workers.size(); }
+
+    /**
+    * Executes the items [0,_n) of a job, spreading them over the
+    * threads of the pool and the calling thread, and returns once
+    * all of them have been completed (join).
+    * @param _task the job.
+    * @param _n the number of items of the job.
+    */
+    void run(iDynNodeTask &_task, const unsigned int _n);
+
+    /**
+    * Destructor: stops and destroys the threads.
+    */
+    ~iDynNodeWorkerPool();
+};
+
+
 /**
 * \ingroup iDynBody
 *
@@ -557,11 +644,39 @@ protected:
     /// total mass of the node
     double mass;
 
+    /// the pool of threads used to solve the limbs concurrently (not owned; NULL if sequential)
+    iDynNodeWorkerPool *pool;
+    /// the indexes of the limbs processed by the current phase
+    std::vector<unsigned int> phaseLimbs;
+    /// the current phase
+    int phase;
+
     /**
     * Reset all data to zero. The list of limbs is not modified or deleted.
     */
     void zero();
 
+    /**
+    * Compute the wrench pass in a limb whose wrench flow is of input type.
+    * @param iLimb the index of the limb
+    */
+    virtual void computeLimbWrenchIn(const unsigned int iLimb);
+
+    /**
+    * Perform the current phase on the k-th limb of phaseLimbs.
+    * @param k the index within phaseLimbs
+    */
+    void runLimbPhase(const unsigned int k);
+
+    /**
+    * Perform a phase on all the limbs listed in phaseLimbs, concurrently
+    * if a pool of threads has been set; returns when all the limbs are done.
+    * @param _phase the phase to be performed
+    */
+    void runPhase(const int _phase);
+
+    friend class iDynNodePhase;
+
     /**
     * Compute Pn and H_A_Node matrices given two chains. This function is private, and
     * is used by computeJacobian() and computePose() to merely avoid code duplication.
@@ -616,6 +731,24 @@ public:
     */
     iDynNode(const std::string &_info, const NewEulMode _mode=DYNAMIC, unsigned int verb=iCub::skinDynLib::VERBOSE);
 
+    /**
+    * Set the pool of threads used to solve concurrently the limbs which
+    * are independent, i.e. the limbs receiving the kinematics from the
+    * node and the limbs sending their wrench to the node. The limbs are
+    * joined at the node before the results are exchanged through the
+    * RigidBodyTransformation, so that the outcome is the same of the
+    * sequential computation.
+    * @param _pool pointer to the pool (not owned by the node); NULL
+    *              restores the sequential computation.
+    */
+    void setWorkerPool(iDynNodeWorkerPool *_pool) { pool=_pool; }
+
+    /**
+    * Return the pool of threads used to solve the limbs.
+    * @return the pointer to the pool, NULL if sequential.
+    */
+    iDynNodeWorkerPool *getWorkerPool() const { return pool; }
+
     /**
     * Add one limb to the node, defining its RigidBodyTransformation. A new RigidBodyTransformation
     * is added to the RBT list.
@@ -924,6 +1057,13 @@ protected:
     */
     unsigned int howManySensors() const;
 
+    /**
+    * Compute the wrench pass in a limb whose wrench flow is of input type,
+    * using its iDynSensor if the limb has a FT sensor.
+    * @param iLimb the index of the limb
+    */
+    virtual void computeLimbWrenchIn(const unsigned int iLimb);
+
 public:
 
     /**
@@ -1473,6 +1613,8 @@ protected:
     /// defining the connection between Upper and Lower Torso
     RigidBodyTransformation * rbt;
     version_tag tag;
+    /// the pool of threads shared by the upper and lower torso nodes
+    iDynNodeWorkerPool * pool;
 
 public:
 
@@ -1508,6 +1650,15 @@ public:
     */
     void attachLowerTorso(const yarp::sig::Vector &FM_right_leg, const yarp::sig::Vector &FM_left_leg);
 
+    /**
+    * Enable the concurrent solution of the independent limbs (arms, legs, head)
+    * within the upper and lower torso nodes. The threads are persistent and are
+    * shared by the two nodes; the nodes themselves are still solved one after
+    * the other, since the lower torso depends on the upper torso.
+    * @param nThreads the number of additional threads (0 to disable).
+    */
+    void setParallelLimbs(const unsigned int nThreads);
+
     /**
     * Performs the computation of the center of mass (COM) of the whole iCub
     * @return true if succeeds, false otherwise
@@ -108,6 +108,8 @@ protected:
     yarp::sig::Vector zm;   
     ///the corresponding iDynLink 
     iDyn::iDynLink *link;   
+    ///preallocated (3x1) buffer handed to the set methods, so that the recursion does not allocate
+    yarp::sig::Vector v3;
 
     //~~~~~~~~~~~~~~~~~~~~~~
     //   set methods  
@@ -428,10 +428,25 @@ void iDynLink::updateHstore()
 {
     if(!H_store_valid)
     {
-        H_store = iKinLink::getH(true);
-        R_store = H_store.submatrix(0,2,0,2);
-        r_store = H_store.subcol(0,3,3);
-        r_proj_store = r_store*R_store;
+        // same as iKinLink::getH(true), but filled in place
+        iKinFrame Hl;
+        computeFrame(Hl);
+        if(r_proj_store.length()!=3)
+        {
+            H_store.resize(4,4); R_store.resize(3,3);
+            r_store.resize(3); r_proj_store.resize(3);
+        }
+        for(int i=0; i<3; i++)
+        {
+            for(int j=0; j<3; j++)
+                H_store(i,j) = R_store(i,j) = Hl(i,j);
+            H_store(i,3) = r_store[i] = Hl(i,3);
+            H_store(3,i) = 0.0;
+        }
+        H_store(3,3) = 1.0;
+        // r_proj_store = r_store*R_store
+        for(int j=0; j<3; j++)
+            r_proj_store[j] = r_store[0]*R_store(0,j)+r_store[1]*R_store(1,j)+r_store[2]*R_store(2,j);
         H_store_valid = true;
     }
 }
@@ -1602,41 +1617,330 @@ Matrix iDynChain::getHCOM(unsigned int iLink)
     return getH(iLink,true) * allList[iLink]->getCOM();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-Matrix iDynChain::computeMassMatrix()
+// Spatial algebra helpers for the recursive algorithms (see R. Featherstone,
+// "Rigid Body Dynamics Algorithms", 2008). Spatial vectors are (angular; linear),
+// expressed in the link frame at its origin, matrices are row-major arrays.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+static inline void cross3(const double *a, const double *b, double *c)
 {
-    Matrix M(DOF,DOF);          // mass matrix
-    iKinLink* l;
-    int hash_i;
-    setDAng(zeros(DOF));        // set to zero the joint vel
-    setD2Ang(zeros(DOF));       // set to zero the joint acc
+    c[0]=a[1]*b[2]-a[2]*b[1];
+    c[1]=a[2]*b[0]-a[0]*b[2];
+    c[2]=a[0]*b[1]-a[1]*b[0];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y=E*x
+static inline void rot3(const double *E, const double *x, double *y)
+{
+    y[0]=E[0]*x[0]+E[1]*x[1]+E[2]*x[2];
+    y[1]=E[3]*x[0]+E[4]*x[1]+E[5]*x[2];
+    y[2]=E[6]*x[0]+E[7]*x[1]+E[8]*x[2];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y=E'*x
+static inline void rotT3(const double *E, const double *x, double *y)
+{
+    y[0]=E[0]*x[0]+E[3]*x[1]+E[6]*x[2];
+    y[1]=E[1]*x[0]+E[4]*x[1]+E[7]*x[2];
+    y[2]=E[2]*x[0]+E[5]*x[1]+E[8]*x[2];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// motion vector from the parent to the link frame: w'=E*w, v'=E*(v+w x r)
+static void motionToChild(const SpatialLink &l, const double *m, double *out)
+{
+    double t[3];
+    cross3(m,l.r,t);
+    t[0]+=m[3]; t[1]+=m[4]; t[2]+=m[5];
+    rot3(l.E,m,out);
+    rot3(l.E,t,out+3);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// force vector from the link to the parent frame: f=E'*f', n=E'*n'+r x f
+static void forceToParent(const SpatialLink &l, const double *f, double *out)
+{
+    double t[3];
+    rotT3(l.E,f+3,out+3);
+    rotT3(l.E,f,out);
+    cross3(l.r,out+3,t);
+    out[0]+=t[0]; out[1]+=t[1]; out[2]+=t[2];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// out=I*x
+static inline void mul6(const double *I, const double *x, double *out)
+{
+    for (int r=0; r<6; r++)
+    {
+        const double *row=I+6*r;
+        out[r]=row[0]*x[0]+row[1]*x[1]+row[2]*x[2]+row[3]*x[3]+row[4]*x[4]+row[5]*x[5];
+    }
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+static inline double dot6(const double *a, const double *b)
+{
+    return a[0]*b[0]+a[1]*b[1]+a[2]*b[2]+a[3]*b[3]+a[4]*b[4]+a[5]*b[5];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Ip+=X'*I*X, X being the motion transform from the parent to the link
+static void addInertiaToParent(const SpatialLink &l, const double *I, double *Ip)
+{
+    // columns of X, i.e. the unit motions of the parent seen by the link
+    double X[36],IX[36],col[6],e[6];
+    for (int c=0; c<6; c++)
+    {
+        for (int k=0; k<6; k++)
+            e[k]=(k==c);
+        motionToChild(l,e,col);
+        for (int k=0; k<6; k++)
+            X[6*k+c]=col[k];
+    }
 
-    if(NE==NULL || NE->getMode()!=DYNAMIC)
-        prepareNewtonEuler(DYNAMIC);
-    initNewtonEuler();                  // init with zero w, dw, ddp, F, Mu
-    NE->ForwardKinematicFromBase();     // propagate zero kinematics from base
-    
-    for(int i=DOF-1; i>=0; i--) // start from the end of the chain
+    for (int c=0; c<6; c++)
     {
-        l = quickList[hash_dof[i]];
-        hash_i = hash[i];
-        l->setD2Ang(1.0);       // set i-th accelleration to 1
-        
-        // forward kinematics from link i-1 to end
-        for(unsigned int j=1+hash_i; j<N+1; j++)
-            NE->neChain[j]->ForwardKinematics(NE->neChain[j-1]);
+        for (int k=0; k<6; k++)
+            col[k]=X[6*k+c];
+        mul6(I,col,e);
+        for (int k=0; k<6; k++)
+            IX[6*k+c]=e[k];
+    }
 
-        // backward wrench from end to link i
-        for(int j=N; j>=hash_i; j--)
-            NE->neChain[j]->BackwardWrench(NE->neChain[j+1]);
+    for (int r=0; r<6; r++)
+        for (int c=0; c<6; c++)
+            Ip[6*r+c]+=X[r]*IX[c]+X[6+r]*IX[6+c]+X[12+r]*IX[12+c]+
+                       X[18+r]*IX[18+c]+X[24+r]*IX[24+c]+X[30+r]*IX[30+c];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// spatial inertia at the link origin from the mass m, the COM c and the
+// rotational inertia Ic about the COM, all in the link frame
+static void spatialInertia(const double m, const double *c, const double *Ic, double *I)
+{
+    // [Ic-m*cx*cx  m*cx; -m*cx  m*1]
+    double cx[9]={0.0,-c[2],c[1], c[2],0.0,-c[0], -c[1],c[0],0.0};
+    for (int r=0; r<3; r++)
+    {
+        for (int k=0; k<3; k++)
+        {
+            double cc=cx[3*r]*cx[k]+cx[3*r+1]*cx[3+k]+cx[3*r+2]*cx[6+k];
+            I[6*r+k]=Ic[3*r+k]-m*cc;
+            I[6*r+3+k]=m*cx[3*r+k];
+            I[6*(3+r)+k]=-m*cx[3*r+k];
+            I[6*(3+r)+3+k]=(r==k)?m:0.0;
+        }
+    }
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// v x m (motion cross product)
+static inline void crossMotion(const double *v, const double *m, double *out)
+{
+    double t[3];
+    cross3(v,m,out);
+    cross3(v,m+3,out+3);
+    cross3(v+3,m,t);
+    out[3]+=t[0]; out[4]+=t[1]; out[5]+=t[2];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// v x* f (force cross product)
+static inline void crossForce(const double *v, const double *f, double *out)
+{
+    double t[3];
+    cross3(v,f,out);
+    cross3(v+3,f+3,t);
+    out[0]+=t[0]; out[1]+=t[1]; out[2]+=t[2];
+    cross3(v,f+3,out+3);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// composite rigid body algorithm: M is DOFxDOF row-major, dof[i] the
+// index of the active link i, Ic is scratch of 36*n doubles
+static void crba(const SpatialLink *links, const int n, const int *dof,
+                 const int DOF, double *Ic, double *M)
+{
+    for (int i=0; i<36*n; i++)
+        Ic[i]=links[i/36].I[i%36];
+
+    for (int i=n-1; i>0; i--)
+        addInertiaToParent(links[i],&Ic[36*i],&Ic[36*(i-1)]);
 
-        // copy the joint torques in the i-th column of M
-        for(unsigned int j=i; j<DOF; j++)
-            M(j,i) = M(i,j) = NE->neChain[hash[j]]->getMoment(true)[2]; 
-        //same as quickList[hash_dof[j]]->getTorque(), but in this way you do not need to call computeTorque
+    for (int i=n-1; i>=0; i--)
+    {
+        if (!links[i].active)
+            continue;
 
-        l->setD2Ang(0.0);          // set i-th accelleration to 0
+        double F[6],Fp[6];
+        int di=dof[i];
+        mul6(&Ic[36*i],links[i].S,F);
+        M[DOF*di+di]=dot6(links[i].S,F);
+
+        for (int j=i; j>0; j--)
+        {
+            forceToParent(links[j],F,Fp);
+            for (int k=0; k<6; k++)
+                F[k]=Fp[k];
+
+            if (links[j-1].active)
+            {
+                int dj=dof[j-1];
+                M[DOF*di+dj]=M[DOF*dj+di]=dot6(links[j-1].S,F);
+            }
+        }
     }
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// articulated body algorithm: dq, tau and ddq are indexed by link, the
+// entries of the blocked links are ignored (ddq set to 0); a0 is the
+// spatial acceleration of the base; scratch is of 62*n doubles
+static void aba(const SpatialLink *links, const int n, const double *dq,
+                const double *tau, const double *a0, double *scratch, double *ddq)
+{
+    double *IA=scratch;           // 36*n
+    double *pA=IA+36*n;           // 6*n
+    double *c =pA+6*n;            // 6*n
+    double *U =c+6*n;             // 6*n
+    double *D =U+6*n;             // n
+    double *u =D+n;               // n
+    double *v =u+n;               // 6*n, reused for the accelerations
+    double vp[6]={0.0,0.0,0.0,0.0,0.0,0.0};
+    double t[6],vJ[6];
+
+    for (int i=0; i<n; i++)
+    {
+        double qd=links[i].active ? dq[i] : 0.0;
+        double *vi=&v[6*i];
+
+        motionToChild(links[i],(i>0)?&v[6*(i-1)]:vp,vi);
+        for (int k=0; k<6; k++)
+        {
+            vJ[k]=links[i].S[k]*qd;
+            vi[k]+=vJ[k];
+        }
 
+        crossMotion(vi,vJ,&c[6*i]);
+
+        for (int k=0; k<36; k++)
+            IA[36*i+k]=links[i].I[k];
+
+        mul6(links[i].I,vi,t);
+        crossForce(vi,t,&pA[6*i]);
+    }
+
+    for (int i=n-1; i>=0; i--)
+    {
+        double *IAi=&IA[36*i];
+        double *pAi=&pA[6*i];
+        double *Ui=&U[6*i];
+
+        if (links[i].active)
+        {
+            mul6(IAi,links[i].S,Ui);
+            D[i]=dot6(links[i].S,Ui);
+            u[i]=tau[i]-dot6(links[i].S,pAi);
+        }
+
+        if (i>0)
+        {
+            double Ia[36],pa[6],pp[6];
+            for (int k=0; k<36; k++)
+                Ia[k]=IAi[k];
+
+            if (links[i].active)
+            {
+                for (int r=0; r<6; r++)
+                    for (int k=0; k<6; k++)
+                        Ia[6*r+k]-=Ui[r]*Ui[k]/D[i];
+            }
+
+            mul6(Ia,&c[6*i],pa);
+            for (int k=0; k<6; k++)
+                pa[k]+=pAi[k];
+
+            if (links[i].active)
+            {
+                for (int k=0; k<6; k++)
+                    pa[k]+=Ui[k]*u[i]/D[i];
+            }
+
+            addInertiaToParent(links[i],Ia,&IA[36*(i-1)]);
+            forceToParent(links[i],pa,pp);
+            for (int k=0; k<6; k++)
+                pA[6*(i-1)+k]+=pp[k];
+        }
+    }
+
+    for (int i=0; i<n; i++)
+    {
+        double *ai=&v[6*i];
+        motionToChild(links[i],(i>0)?&v[6*(i-1)]:a0,ai);
+        for (int k=0; k<6; k++)
+            ai[k]+=c[6*i+k];
+
+        if (links[i].active)
+        {
+            ddq[i]=(u[i]-dot6(&U[6*i],ai))/D[i];
+            for (int k=0; k<6; k++)
+                ai[k]+=links[i].S[k]*ddq[i];
+        }
+        else
+            ddq[i]=0.0;
+    }
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void iDynChain::computeSpatialLinks()
+{
+    if (spatialLinks.size()!=N)
+        spatialLinks.resize(N);
+
+    if (spatialDof.size()!=N)
+        spatialDof.resize(N);
+
+    for (unsigned int i=0; i<N; i++)
+        spatialDof[i]=-1;
+    for (unsigned int i=0; i<DOF; i++)
+        spatialDof[hash[i]]=i;
+
+    for (unsigned int i=0; i<N; i++)
+    {
+        iDynLink *l=refLink(i);
+        SpatialLink &sl=spatialLinks[i];
+
+        // same quantities used by OneLinkNewtonEuler
+        const Matrix &R=l->getR();
+        const Vector &r=l->getr();
+        const Vector &rp=l->getr(true);
+        const Vector &rc=l->getrC();
+        const Matrix &Ic=l->getInertia();
+
+        for (int j=0; j<3; j++)
+        {
+            for (int k=0; k<3; k++)
+                sl.E[3*j+k]=R(k,j);
+            sl.r[j]=r[j];
+        }
+
+        // the joint rotates about z of the parent frame, passing through its origin
+        double a[3]={R(2,0),R(2,1),R(2,2)};
+        double p[3]={rp[0],rp[1],rp[2]};
+        sl.S[0]=a[0]; sl.S[1]=a[1]; sl.S[2]=a[2];
+        cross3(a,p,sl.S+3);
+
+        double c[3]={rc[0],rc[1],rc[2]};
+        double I[9];
+        for (int j=0; j<3; j++)
+            for (int k=0; k<3; k++)
+                I[3*j+k]=Ic(j,k);
+        spatialInertia(l->getMass(),c,I,sl.I);
+
+        sl.active=(spatialDof[i]>=0);
+    }
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Matrix iDynChain::computeMassMatrix()
+{
+    Matrix M(DOF,DOF);          // mass matrix
+    if (DOF==0)
+        return M;
+
+    computeSpatialLinks();
+    if (spatialWork.size()<36*N)
+        spatialWork.resize(36*N);
+
+    crba(&spatialLinks[0],N,&spatialDof[0],DOF,&spatialWork[0],M.data());
     return M;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -1646,9 +1950,9 @@ Matrix iDynChain::computeMassMatrix(const Vector& q)
     return computeMassMatrix();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-// This is a simpler version of the method, just to understand what the method does.
-// The new version is about 2 times faster than this, because it exploits the fact that
-// the mass matrix is symmetric (but it is a little harder to understand the code).
+// This is the Newton-Euler formulation of the method, just to understand what the method does:
+// the i-th column of M is given by the torques produced by a unit acceleration of the i-th joint.
+// The CRBA version above gives the same matrix in O(n^2) flops without any allocation.
 //Matrix iDynChain::computeMassMatrix()
 //{
 //    // mass matrix
@@ -1730,6 +2034,56 @@ Vector iDynChain::computeCcGravityTorques(const Vector& ddp0, const Vector& q, c
     setDAng(dq);
     return computeCcGravityTorques(ddp0);
 }
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Vector iDynChain::computeForwardDynamics(const Vector& q, const Vector& dq, const Vector& tau)
+{
+    Vector zero3(3,0.0);
+    return computeForwardDynamics(q,dq,tau,zero3);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Vector iDynChain::computeForwardDynamics(const Vector& q, const Vector& dq, const Vector& tau, const Vector& ddp0)
+{
+    Vector ddq(DOF,0.0);
+    if (DOF==0)
+        return ddq;
+
+    if ((tau.length()!=DOF) || (ddp0.length()!=3))
+    {
+        if(verbose) yError("iDynChain: error, computeForwardDynamics() failed due to wrong sized vectors: tau %d instead of %d, ddp0 %d instead of 3 \n",(int)tau.length(),DOF,(int)ddp0.length());
+        return ddq;
+    }
+
+    setAng(q);
+    setDAng(dq);
+    computeSpatialLinks();
+
+    // workspace of aba() followed by dq, tau and ddq of every link
+    if (spatialWork.size()<(62+3)*N)
+        spatialWork.resize((62+3)*N);
+    double *dqL=&spatialWork[62*N];
+    double *tauL=dqL+N;
+    double *ddqL=tauL+N;
+
+    for (unsigned int i=0; i<N; i++)
+    {
+        int d=spatialDof[i];
+        dqL[i]=(d>=0)?curr_dq[d]:0.0;
+        tauL[i]=(d>=0)?tau[d]:0.0;
+    }
+
+    // as for the Newton-Euler base, the acceleration of the base accounts for gravity
+    // and is expressed in the base frame, i.e. rotated by H0^T (see BaseLinkNewtonEuler);
+    // the base angular acceleration is zero as in computeCcGravityTorques()
+    double a0[6]={0.0,0.0,0.0,0.0,0.0,0.0};
+    for (int i=0; i<3; i++)
+        a0[3+i]=H0(0,i)*ddp0[0]+H0(1,i)*ddp0[1]+H0(2,i)*ddp0[2];
+    aba(&spatialLinks[0],N,dqL,tauL,a0,&spatialWork[0],ddqL);
+
+    for (unsigned int i=0; i<DOF; i++)
+        ddq[i]=ddqL[hash[i]];
+
+    return ddq;
+}
 
 
 //================================
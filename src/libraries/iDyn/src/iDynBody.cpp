@@ -34,7 +34,98 @@ using namespace iCub::iKin;
 using namespace iCub::iDyn;
 using namespace iCub::skinDynLib;
 
+// phases of the node solution performed limb-wise by iDynNode::runLimbPhase()
+enum { NODE_PHASE_KIN_OUT=0, NODE_PHASE_WRE_IN, NODE_PHASE_WRE_OUT };
+
+namespace iCub
+{
+
+namespace iDyn
+{
+
+class iDynNodeWorker : public Thread
+{
+    iDynNodeWorkerPool &pool;
+    unsigned int id;
+    Semaphore go;
+
+public:
+    iDynNodeWorker(iDynNodeWorkerPool &_pool, const unsigned int _id) :
+                   pool(_pool), id(_id), go(0) { }
+
+    void trigger() { go.post(); }
+
+    void onStop() { go.post(); }
+
+    void run()
+    {
+        while (true)
+        {
+            go.wait();
+            if (isStopping())
+                break;
+
+            pool.execShare(id);
+        }
+    }
+};
+
+class iDynNodePhase : public iDynNodeTask
+{
+    iDynNode &node;
+
+public:
+    iDynNodePhase(iDynNode &_node) : node(_node) { }
+
+    void exec(const unsigned int i)
+    {
+        node.runLimbPhase(i);
+    }
+};
+
+}
+
+}
+
 // #define DEBUG_FOOT_COM
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Fixed-size kernels of the RBT propagation: same evaluation order as the
+// yarp::math expressions they replace, no temporaries. R is 3x3 row-major.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+static inline void cross3(const double *a, const double *b, double *c)
+{
+    c[0]=a[1]*b[2]-a[2]*b[1];
+    c[1]=a[2]*b[0]-a[0]*b[2];
+    c[2]=a[0]*b[1]-a[1]*b[0];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y=R*x
+static inline void mulRx(const double *R, const double *x, double *y)
+{
+    y[0]=R[0]*x[0]+R[1]*x[1]+R[2]*x[2];
+    y[1]=R[3]*x[0]+R[4]*x[1]+R[5]*x[2];
+    y[2]=R[6]*x[0]+R[7]*x[1]+R[8]*x[2];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y=R'*x
+static inline void mulRTx(const double *R, const double *x, double *y)
+{
+    y[0]=R[0]*x[0]+R[3]*x[1]+R[6]*x[2];
+    y[1]=R[1]*x[0]+R[4]*x[1]+R[7]*x[2];
+    y[2]=R[2]*x[0]+R[5]*x[1]+R[8]*x[2];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// splits the roto-translation H into R (3x3), r and its projection R'*r
+static inline void splitRBT(const Matrix &H, double *R, double *r, double *rp)
+{
+    for(int i=0; i<3; i++)
+    {
+        R[3*i]=H(i,0); R[3*i+1]=H(i,1); R[3*i+2]=H(i,2);
+        r[i]=H(i,3);
+    }
+    mulRTx(R,r,rp);
+}
 //====================================
 //
 //      RIGID BODY TRANSFORMATION
@@ -173,8 +264,11 @@ void RigidBodyTransformation::getWrench(Vector &FNode, Vector &MuNode)
     computeWrench();
 
     //apply the wrench computations to the node
-    FNode = FNode + F;
-    MuNode = MuNode + Mu;
+    for(int i=0; i<3; i++)
+    {
+        FNode[i] += F[i];
+        MuNode[i] += Mu[i];
+    }
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void RigidBodyTransformation::setInfoFlow(const FlowType kin, const FlowType wre)
@@ -202,19 +296,30 @@ void RigidBodyTransformation::computeKinematic()
         // but here are fastened and adapted to the RBT
         // note: w,dw,ddp are already set with the ones coming from the LIMB
 
+        double R[9], r[3], rp[3], t[3], c[3], cc[3];
+        splitRBT(H,R,r,rp);
         switch(mode)
         {
         case DYNAMIC:
         case DYNAMIC_CORIOLIS_GRAVITY:
         case DYNAMIC_W_ROTOR:
-            ddp = getR() * ( ddp - cross(dw,getr(true)) - cross(w,cross(w,getr(true))) ) ;
-            w   = getR() * w ;
-            dw  = getR() * dw ; 
+            // ddp = R * ( ddp - dw x rp - w x (w x rp) ), w = R*w, dw = R*dw
+            cross3(dw.data(),rp,c);
+            cross3(w.data(),rp,t);
+            cross3(w.data(),t,cc);
+            for(int i=0; i<3; i++)
+                t[i] = (ddp[i]-c[i])-cc[i];
+            mulRx(R,t,ddp.data());
+            t[0]=w[0]; t[1]=w[1]; t[2]=w[2];
+            mulRx(R,t,w.data());
+            t[0]=dw[0]; t[1]=dw[1]; t[2]=dw[2];
+            mulRx(R,t,dw.data());
             break;
         case STATIC:    
             w   = 0.0;
             dw  = 0.0;
-            ddp = getR() * ddp;
+            t[0]=ddp[0]; t[1]=ddp[1]; t[2]=ddp[2];
+            mulRx(R,t,ddp.data());
             break;
         }
     }
@@ -225,19 +330,31 @@ void RigidBodyTransformation::computeKinematic()
         // but here are fastened and adapted to the RBT
         // note: w,dw,ddp are already set with the ones coming from the NODE
 
+        double R[9], r[3], rp[3], t[3], c[3], cc[3];
+        splitRBT(H,R,r,rp);
         switch(mode)
         {
         case DYNAMIC:
         case DYNAMIC_CORIOLIS_GRAVITY:
         case DYNAMIC_W_ROTOR:
-            w   = getR().transposed() * w ;
-            dw  = getR().transposed() * dw;
-            ddp = getR().transposed() * (ddp) + cross(dw,getr(true)) + cross(w,cross(w,getr(true))) ;
+            // w = R'*w, dw = R'*dw, ddp = R'*ddp + dw x rp + w x (w x rp)
+            t[0]=w[0]; t[1]=w[1]; t[2]=w[2];
+            mulRTx(R,t,w.data());
+            t[0]=dw[0]; t[1]=dw[1]; t[2]=dw[2];
+            mulRTx(R,t,dw.data());
+            t[0]=ddp[0]; t[1]=ddp[1]; t[2]=ddp[2];
+            mulRTx(R,t,ddp.data());
+            cross3(dw.data(),rp,c);
+            cross3(w.data(),rp,t);
+            cross3(w.data(),t,cc);
+            for(int i=0; i<3; i++)
+                ddp[i] = (ddp[i]+c[i])+cc[i];
             break;
         case STATIC:    
             w   = 0.0;
             dw  = 0.0;
-            ddp =  getR().transposed() * ddp ;
+            t[0]=ddp[0]; t[1]=ddp[1]; t[2]=ddp[2];
+            mulRTx(R,t,ddp.data());
             break;
         }
     
@@ -254,8 +371,17 @@ void RigidBodyTransformation::computeWrench()
         // note: no switch(mode) is necessary because all modes have the same formula
         // note: F,Mu are already set with the ones coming from the LIMB
 
-        Mu = cross( getr(), getR()*F ) + getR() * Mu ;
-        F  = getR() * F;
+        // Mu = r x (R*F) + R*Mu, F = R*F
+        double R[9], r[3], rp[3], RF[3], RMu[3];
+        splitRBT(H,R,r,rp);
+        mulRx(R,F.data(),RF);
+        mulRx(R,Mu.data(),RMu);
+        cross3(r,RF,Mu.data());
+        for(int i=0; i<3; i++)
+        {
+            Mu[i] += RMu[i];
+            F[i] = RF[i];
+        }
     }
     else
     {
@@ -265,8 +391,16 @@ void RigidBodyTransformation::computeWrench()
         // note: no switch(mode) is necessary because all modes have the same formula
         // note: F,Mu are already set with the ones coming from the NODE
 
-        Mu = getR().transposed() * ( Mu - cross(getr(),getR() * F ));
-        F  = getR().transposed() * F ;
+        // Mu = R'*(Mu - r x (R*F)), F = R'*F
+        double R[9], r[3], rp[3], RF[3], t[3];
+        splitRBT(H,R,r,rp);
+        mulRx(R,F.data(),RF);
+        cross3(r,RF,t);
+        for(int i=0; i<3; i++)
+            t[i] = Mu[i]-t[i];
+        mulRTx(R,t,Mu.data());
+        t[0]=F[0]; t[1]=F[1]; t[2]=F[2];
+        mulRTx(R,t,F.data());
         
     }
 }
@@ -407,6 +541,80 @@ Matrix RigidBodyTransformation::getHCOM(unsigned int iLink)
 
 
 
+//====================================
+//
+//      i DYN NODE WORKER POOL
+//
+//====================================
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+iDynNodeWorkerPool::iDynNodeWorkerPool(const unsigned int nThreads) : done(0)
+{
+    task=NULL;
+    n=stride=0;
+
+    for (unsigned int k=0; k<nThreads; k++)
+    {
+        iDynNodeWorker *worker=new iDynNodeWorker(*this,k);
+        worker->start();
+        workers.push_back(worker);
+    }
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void iDynNodeWorkerPool::execShare(const unsigned int id)
+{
+    // the calling thread takes the items 0, stride, 2*stride, ...
+    for (unsigned int i=id+1; i<n; i+=stride)
+        task->exec(i);
+
+    done.post();
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void iDynNodeWorkerPool::run(iDynNodeTask &_task, const unsigned int _n)
+{
+    unsigned int nUsed=(_n>0?_n-1:0);
+    if (nUsed>workers.size())
+        nUsed=(unsigned int)workers.size();
+
+    if (nUsed==0)
+    {
+        for (unsigned int i=0; i<_n; i++)
+            _task.exec(i);
+
+        return;
+    }
+
+    task=&_task;
+    n=_n;
+    stride=nUsed+1;
+
+    for (unsigned int k=0; k<nUsed; k++)
+        workers[k]->trigger();
+
+    for (unsigned int i=0; i<n; i+=stride)
+        task->exec(i);
+
+    // join
+    for (unsigned int k=0; k<nUsed; k++)
+        done.wait();
+
+    task=NULL;
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+iDynNodeWorkerPool::~iDynNodeWorkerPool()
+{
+    for (unsigned int k=0; k<workers.size(); k++)
+    {
+        workers[k]->stop();
+        delete workers[k];
+    }
+
+    workers.clear();
+}
+
+
+
+
 //====================================
 //
 //      i DYN NODE
@@ -419,6 +627,8 @@ iDynNode::iDynNode(const NewEulMode _mode)
     rbtList.clear();
     mode = _mode;
     verbose = iCub::skinDynLib::VERBOSE;
+    pool = NULL;
+    phase = NODE_PHASE_KIN_OUT;
     zero();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -428,9 +638,55 @@ iDynNode::iDynNode(const string &_info, const NewEulMode _mode, unsigned int ver
     rbtList.clear();
     mode = _mode;
     verbose = verb;
+    pool = NULL;
+    phase = NODE_PHASE_KIN_OUT;
     zero();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void iDynNode::computeLimbWrenchIn(const unsigned int iLimb)
+{
+    rbtList[iLimb].computeLimbWrench();
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void iDynNode::runLimbPhase(const unsigned int k)
+{
+    unsigned int i=phaseLimbs[k];
+    switch (phase)
+    {
+    case NODE_PHASE_KIN_OUT:
+        //init the kinematics with the node information
+        rbtList[i].setKinematic(w,dw,ddp);
+        //solve kinematics in that limb/chain
+        rbtList[i].computeLimbKinematic();
+        break;
+
+    case NODE_PHASE_WRE_IN:
+        //compute the wrench pass in that limb
+        computeLimbWrenchIn(i);
+        break;
+
+    case NODE_PHASE_WRE_OUT:
+        //init the wrench with the node information
+        rbtList[i].setWrench(F,Mu);
+        //solve wrench in that limb/chain
+        rbtList[i].computeLimbWrench();
+        break;
+    }
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void iDynNode::runPhase(const int _phase)
+{
+    phase=_phase;
+    if (pool!=NULL)
+    {
+        // the limbs only share read-only node data within a phase
+        iDynNodePhase job(*this);
+        pool->run(job,(unsigned int)phaseLimbs.size());
+    }
+    else for (unsigned int k=0; k<phaseLimbs.size(); k++)
+        runLimbPhase(k);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void iDynNode::zero()
 {
     w.resize(3); w.zero();
@@ -484,16 +740,12 @@ bool iDynNode::solveKinematics()
     if(inputNode==1)
     {
         //now forward the kinematic input from limbs whose kinematic flow is input type
+        //the limbs are independent once the node is known
+        phaseLimbs.clear();
         for(unsigned int i=0; i<rbtList.size(); i++)
-        {
             if(rbtList[i].getKinematicFlow()==RBT_NODE_OUT)
-            {
-                //init the kinematics with the node information
-                rbtList[i].setKinematic(w,dw,ddp);
-                //solve kinematics in that limb/chain
-                rbtList[i].computeLimbKinematic();
-            }
-        }
+                phaseLimbs.push_back(i);
+        runPhase(NODE_PHASE_KIN_OUT);
         return true;
     
     }
@@ -533,16 +785,12 @@ bool iDynNode::solveKinematics(const Vector &w0, const Vector &dw0, const Vector
     if(inputNode==1)
     {
         //now forward the kinematic input from limbs whose kinematic flow is input type
+        //the limbs are independent once the node is known
+        phaseLimbs.clear();
         for(unsigned int i=0; i<rbtList.size(); i++)
-        {
             if(rbtList[i].getKinematicFlow()==RBT_NODE_OUT)
-            {
-                //init the kinematics with the node information
-                rbtList[i].setKinematic(w,dw,ddp);
-                //solve kinematics in that limb/chain
-                rbtList[i].computeLimbKinematic();
-            }
-        }
+                phaseLimbs.push_back(i);
+        runPhase(NODE_PHASE_KIN_OUT);
         return true;
     
     }
@@ -596,19 +844,22 @@ bool iDynNode::solveWrench()
     //first get the forces/moments from each limb
     //assuming that each limb has been properly set with the outcoming measured
     //forces/moments which are necessary for the wrench computation
+    //the wrench pass of each limb is independent: the limbs are joined
+    //before summing, which is done in the order of insertion
+    phaseLimbs.clear();
     for(unsigned int i=0; i<rbtList.size(); i++)
+        if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)
+            phaseLimbs.push_back(i);
+    runPhase(NODE_PHASE_WRE_IN);
+
+    for(unsigned int k=0; k<phaseLimbs.size(); k++)
     {
-        if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)         
-        {
-            //compute the wrench pass in that limb
-            rbtList[i].computeLimbWrench();
-            //update the node force/moment with the wrench coming from the limb base/end
-            // note that getWrench sum the result to F,Mu - because they are passed by reference
-            // F = F + F[i], Mu = Mu + Mu[i]
-            rbtList[i].getWrench(F,Mu);
-            //check
-            outputNode++;
-        }
+        //update the node force/moment with the wrench coming from the limb base/end
+        // note that getWrench sum the result to F,Mu - because they are passed by reference
+        // F = F + F[i], Mu = Mu + Mu[i]
+        rbtList[phaseLimbs[k]].getWrench(F,Mu);
+        //check
+        outputNode++;
     }
 
     // node summation: already performed by each RBT
@@ -629,16 +880,11 @@ bool iDynNode::solveWrench()
     }
 
     //now forward the wrench output from the node to limbs whose wrench flow is output type
+    phaseLimbs.clear();
     for(unsigned int i=0; i<rbtList.size(); i++)
-    {
         if(rbtList[i].getWrenchFlow()==RBT_NODE_OUT)
-        {
-            //init the wrench with the node information
-            rbtList[i].setWrench(F,Mu);
-            //solve wrench in that limb/chain
-            rbtList[i].computeLimbWrench();
-        }
-    }
+            phaseLimbs.push_back(i);
+    runPhase(NODE_PHASE_WRE_OUT);
     return true;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -660,7 +906,6 @@ bool iDynNode::setWrenchMeasure(const Matrix &FM)
 {
     Vector fi(3); fi.zero();
     Vector mi(3); mi.zero();
-    Vector FMi(6);FMi.zero();
     bool inputWasOk = true;
 
     //check how many limbs have wrench input
@@ -701,9 +946,8 @@ bool iDynNode::setWrenchMeasure(const Matrix &FM)
             if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)         
             {
                 // from the input matrix - read the input wrench
-                FMi = FM.getCol(inputNode);
-                fi[0]=FMi[0];fi[1]=FMi[1];fi[2]=FMi[2];
-                mi[0]=FMi[3];mi[1]=FMi[4];mi[2]=FMi[5];
+                fi[0]=FM(0,inputNode);fi[1]=FM(1,inputNode);fi[2]=FM(2,inputNode);
+                mi[0]=FM(3,inputNode);mi[1]=FM(4,inputNode);mi[2]=FM(5,inputNode);
                 inputNode++;
                 //set the input wrench in the RBT->limb
                 rbtList[i].setWrenchMeasure(fi,mi);
@@ -1350,6 +1594,16 @@ void iDynSensorNode::addLimb(iDynLimb *limb, const Matrix &H, iDynSensor *sensor
     sensorList.push_back(sensor);
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void iDynSensorNode::computeLimbWrenchIn(const unsigned int iLimb)
+{
+    // if there's a sensor, we must use iDynSensor
+    // otherwise we use the limb method as usual
+    if(rbtList[iLimb].isSensorized()==true)
+        sensorList[iLimb]->computeWrenchFromSensorNewtonEuler();
+    else
+        rbtList[iLimb].computeLimbWrench();
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 bool iDynSensorNode::solveWrench()
 {
     unsigned int outputNode = 0;
@@ -1359,25 +1613,22 @@ bool iDynSensorNode::solveWrench()
     //first get the forces/moments from each limb
     //assuming that each limb has been properly set with the outcoming measured
     //forces/moments which are necessary for the wrench computation
+    //the wrench pass of each limb is independent: the limbs are joined
+    //before summing, which is done in the order of insertion
+    phaseLimbs.clear();
     for(unsigned int i=0; i<rbtList.size(); i++)
-    {
-        if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)         
-        {
-            //compute the wrench pass in that limb
-            // if there's a sensor, we must use iDynSensor
-            // otherwise we use the limb method as usual
-            if(rbtList[i].isSensorized()==true)
-                sensorList[i]->computeWrenchFromSensorNewtonEuler();
-            else
-                rbtList[i].computeLimbWrench();
+        if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)
+            phaseLimbs.push_back(i);
+    runPhase(NODE_PHASE_WRE_IN);
 
-            //update the node force/moment with the wrench coming from the limb base/end
-            // note that getWrench sum the result to F,Mu - because they are passed by reference
-            // F = F + F[i], Mu = Mu + Mu[i]
-            rbtList[i].getWrench(F,Mu);
-            //check
-            outputNode++;
-        }
+    for(unsigned int k=0; k<phaseLimbs.size(); k++)
+    {
+        //update the node force/moment with the wrench coming from the limb base/end
+        // note that getWrench sum the result to F,Mu - because they are passed by reference
+        // F = F + F[i], Mu = Mu + Mu[i]
+        rbtList[phaseLimbs[k]].getWrench(F,Mu);
+        //check
+        outputNode++;
     }
 
     // node summation: already performed by each RBT
@@ -1398,16 +1649,11 @@ bool iDynSensorNode::solveWrench()
 
     //now forward the wrench output from the node to limbs whose wrench flow is output type
     // assuming they don't have a FT sensor
+    phaseLimbs.clear();
     for(unsigned int i=0; i<rbtList.size(); i++)
-    {
         if(rbtList[i].getWrenchFlow()==RBT_NODE_OUT)
-        {
-            //init the wrench with the node information
-            rbtList[i].setWrench(F,Mu);
-            //solve wrench in that limb/chain
-            rbtList[i].computeLimbWrench();
-        }
-    }
+            phaseLimbs.push_back(i);
+    runPhase(NODE_PHASE_WRE_OUT);
     return true;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -1415,7 +1661,6 @@ bool iDynSensorNode::setWrenchMeasure(const Matrix &FM, bool afterAttach)
 {
     Vector fi(3); fi.zero();
     Vector mi(3); mi.zero();
-    Vector FMi(6);FMi.zero();
     bool inputWasOk = true;
 
     //check how many limbs have wrench input
@@ -1460,9 +1705,8 @@ bool iDynSensorNode::setWrenchMeasure(const Matrix &FM, bool afterAttach)
             if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)         
             {
                 // from the input matrix - read the input wrench
-                FMi = FM.getCol(inputNode);
-                fi[0]=FMi[0];fi[1]=FMi[1];fi[2]=FMi[2];
-                mi[0]=FMi[3];mi[1]=FMi[4];mi[2]=FMi[5];
+                fi[0]=FM(0,inputNode);fi[1]=FM(1,inputNode);fi[2]=FM(2,inputNode);
+                mi[0]=FM(3,inputNode);mi[1]=FM(4,inputNode);mi[2]=FM(5,inputNode);
                 inputNode++;
                 //set the input wrench in the RBT->limb
                 // if there's a sensor, set on the sensor
@@ -1568,7 +1812,6 @@ Matrix iDynSensorNode::estimateSensorsWrench(const Matrix &FM, bool afterAttach)
     bool inputWasOk = true;
     Vector fi(3); fi.zero();
     Vector mi(3); mi.zero();
-    Vector FMi(6);FMi.zero();
     Matrix ret;
     
     //reset node wrench
@@ -1609,9 +1852,8 @@ Matrix iDynSensorNode::estimateSensorsWrench(const Matrix &FM, bool afterAttach)
             if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)         
             {
                 // from the input matrix - read the input wrench
-                FMi = FM.getCol(inputNode);
-                fi[0]=FMi[0];fi[1]=FMi[1];fi[2]=FMi[2];
-                mi[0]=FMi[3];mi[1]=FMi[4];mi[2]=FMi[5];
+                fi[0]=FM(0,inputNode);fi[1]=FM(1,inputNode);fi[2]=FM(2,inputNode);
+                mi[0]=FM(3,inputNode);mi[1]=FM(4,inputNode);mi[2]=FM(5,inputNode);
                 inputNode++;
                 //set the input wrench in the RBT->limb
                 // set on base/end as usual
@@ -2406,6 +2648,9 @@ iCubWholeBody::iCubWholeBody(version_tag _tag, const NewEulMode mode, unsigned i
     H.eye();
     //H  is no used currently since the transformation is an identity
     rbt = new RigidBodyTransformation(lowerTorso->up,H,"connection between lower and upper torso",false,RBT_NODE_OUT,RBT_NODE_OUT,mode,verbose);
+
+    //limbs are solved sequentially by default
+    pool = NULL;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 iCubWholeBody::~iCubWholeBody()
@@ -2413,6 +2658,21 @@ iCubWholeBody::~iCubWholeBody()
     if (upperTorso) delete upperTorso; upperTorso = NULL;
     if (lowerTorso) delete lowerTorso; lowerTorso = NULL;
     if (rbt)        delete rbt;        rbt        = NULL;
+    if (pool)       delete pool;       pool       = NULL;
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void iCubWholeBody::setParallelLimbs(const unsigned int nThreads)
+{
+    upperTorso->setWorkerPool(NULL);
+    lowerTorso->setWorkerPool(NULL);
+    if (pool) delete pool; pool = NULL;
+
+    if (nThreads>0)
+    {
+        pool = new iDynNodeWorkerPool(nThreads);
+        upperTorso->setWorkerPool(pool);
+        lowerTorso->setWorkerPool(pool);
+    }
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void iCubWholeBody::attachLowerTorso(const Vector &FM_right_leg, const Vector &FM_left_leg)
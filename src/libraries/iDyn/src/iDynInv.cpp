@@ -36,6 +36,82 @@ using namespace iCub::iDyn;
 using namespace iCub::skinDynLib;
 
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Fixed-size (3x1, 3x3 row-major) kernels of the recursion. They keep the
+// evaluation order of the yarp::math expressions they replace (left to right
+// sums), hence the results are unchanged, but nothing is allocated.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+static inline void cross3(const double *a, const double *b, double *c)
+{
+    c[0]=a[1]*b[2]-a[2]*b[1];
+    c[1]=a[2]*b[0]-a[0]*b[2];
+    c[2]=a[0]*b[1]-a[1]*b[0];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y=R*x
+static inline void mulRx(const double *R, const double *x, double *y)
+{
+    y[0]=R[0]*x[0]+R[1]*x[1]+R[2]*x[2];
+    y[1]=R[3]*x[0]+R[4]*x[1]+R[5]*x[2];
+    y[2]=R[6]*x[0]+R[7]*x[1]+R[8]*x[2];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y=x'*R (i.e. R'*x)
+static inline void mulxR(const double *x, const double *R, double *y)
+{
+    y[0]=x[0]*R[0]+x[1]*R[3]+x[2]*R[6];
+    y[1]=x[0]*R[1]+x[1]*R[4]+x[2]*R[7];
+    y[2]=x[0]*R[2]+x[1]*R[5]+x[2]*R[8];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y+=s*x
+static inline void addScaled3(double *y, const double s, const double *x)
+{
+    y[0]+=s*x[0]; y[1]+=s*x[1]; y[2]+=s*x[2];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y+=s*(a x b)
+static inline void addCross3(double *y, const double s, const double *a, const double *b)
+{
+    double c[3];
+    cross3(a,b,c);
+    addScaled3(y,s,c);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y+=s*(w x (w x r))
+static inline void addCrossCross3(double *y, const double s, const double *w, const double *r)
+{
+    double c[3];
+    cross3(w,r,c);
+    addCross3(y,s,w,c);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y+=s*(I*x)
+static inline void addMul3(double *y, const double s, const double *I, const double *x)
+{
+    double c[3];
+    mulRx(I,x,c);
+    addScaled3(y,s,c);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y+=s*(w x (I*w))
+static inline void addGyro3(double *y, const double s, const double *I, const double *w)
+{
+    double c[3];
+    mulRx(I,w,c);
+    addCross3(y,s,w,c);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// y+=s*((r+rc) x (m*a))
+static inline void addMassMoment3(double *y, const double s, const double *r, const double *rc,
+                                  const double m, const double *a)
+{
+    double d[3]={r[0]+rc[0], r[1]+rc[1], r[2]+rc[2]};
+    double f[3]={m*a[0], m*a[1], m*a[2]};
+    addCross3(y,s,d,f);
+}
+
+
 //================================
 //
 //      ONE LINK NEWTON EULER
@@ -51,6 +127,7 @@ OneLinkNewtonEuler::OneLinkNewtonEuler(iDynLink *dlink)
     link = dlink;
     z0.resize(3); z0.zero(); z0(2)=1;   
     zm.resize(3); zm.zero();
+    v3.resize(3); v3.zero();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 OneLinkNewtonEuler::OneLinkNewtonEuler(const NewEulMode _mode, unsigned int verb, iDynLink *dlink)
@@ -61,6 +138,7 @@ OneLinkNewtonEuler::OneLinkNewtonEuler(const NewEulMode _mode, unsigned int verb
     link = dlink;
     z0.resize(3); z0.zero(); z0(2)=1;   
     zm.resize(3); zm.zero();
+    v3.resize(3); v3.zero();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void OneLinkNewtonEuler::zero()
@@ -393,14 +471,16 @@ void OneLinkNewtonEuler::computeAngVel(OneLinkNewtonEuler *prev)
     case DYNAMIC:
     case DYNAMIC_W_ROTOR:
         {
-            Vector w = prev->getAngVel();
-            w[2] += getDq();
-            setAngVel(w*getR());
+            const double *pw = prev->getAngVel().data();
+            double w[3] = {pw[0], pw[1], pw[2]+getDq()};
+            mulxR(w,getR().data(),v3.data());
+            setAngVel(v3);
             //setAngVel( getR().transposed() * ( prev->getAngVel() + getDq() * z0 ));
             break;
         }
     case STATIC:
-        setAngVel(zeros(3));
+        v3.zero();
+        setAngVel(v3);
         break;
     }
 }
@@ -413,14 +493,16 @@ void OneLinkNewtonEuler::computeAngVelBackward(OneLinkNewtonEuler *next)
     case DYNAMIC:
     case DYNAMIC_W_ROTOR:
         {
-            Vector w = next->getR() * next->getAngVel();
+            double *w = v3.data();
+            mulRx(next->getR().data(),next->getAngVel().data(),w);
             w[2] -= next->getDq();
-            setAngVel(w);
+            setAngVel(v3);
             //setAngVel( next->getR() * next->getAngVel() - next->getDq() * z0 );
             break;
         }
     case STATIC:
-        setAngVel(zeros(3));
+        v3.zero();
+        setAngVel(v3);
         break;
     }
 }
@@ -432,27 +514,32 @@ void OneLinkNewtonEuler::computeAngAcc(OneLinkNewtonEuler *prev)
     case DYNAMIC:
     case DYNAMIC_W_ROTOR:
         {
-            Vector dw = prev->getAngAcc();
-            const Vector& prevW = prev->getAngVel();
+            const double *pdw = prev->getAngAcc().data();
+            const double *prevW = prev->getAngVel().data();
+            double dw[3] = {pdw[0], pdw[1], pdw[2]};
             dw[0] += getDq()*prevW[1];
             dw[1] -= getDq()*prevW[0];
             dw[2] += getD2q();
-            setAngAcc(dw * getR());
+            mulxR(dw,getR().data(),v3.data());
+            setAngAcc(v3);
             //setAngAcc( (getR()).transposed() * ( prev->getAngAcc() + getD2q()*z0 + getDq() * cross(prev->getAngVel(),z0));
             break;
         }
     case DYNAMIC_CORIOLIS_GRAVITY:
         {
-            Vector dw = prev->getAngAcc();
-            const Vector& prevW = prev->getAngVel();
+            const double *pdw = prev->getAngAcc().data();
+            const double *prevW = prev->getAngVel().data();
+            double dw[3] = {pdw[0], pdw[1], pdw[2]};
             dw[0] += getDq()*prevW[1];
             dw[1] -= getDq()*prevW[0];
-            setAngAcc(dw * getR());
+            mulxR(dw,getR().data(),v3.data());
+            setAngAcc(v3);
             //setAngAcc( (getR()).transposed() * ( prev->getAngAcc() + getDq() * cross(prev->getAngVel(),z0) ));
             break;
         }
     case STATIC:
-        setAngAcc(zeros(3));
+        v3.zero();
+        setAngAcc(v3);
         break;
     }
 }
@@ -464,77 +551,85 @@ void OneLinkNewtonEuler::computeAngAccBackward(OneLinkNewtonEuler *next)
     case DYNAMIC:
     case DYNAMIC_W_ROTOR:
         {
-            Vector nextDw = next->getR() * next->getAngAcc();
-            const Vector& w = getAngVel();
+            double *nextDw = v3.data();
+            mulRx(next->getR().data(),next->getAngAcc().data(),nextDw);
+            const double *w = getAngVel().data();
             nextDw[0] -= next->getDq()*w[1];
             nextDw[1] += next->getDq()*w[0];
             nextDw[2] -= next->getD2q();
-            setAngAcc(nextDw);
+            setAngAcc(v3);
             //setAngAcc( next->getR() * next->getAngAcc() - next->getD2q() * z0 - next->getDq() * cross(getAngVel(),z0) );
             break;
         }
     case DYNAMIC_CORIOLIS_GRAVITY:
         {
-            Vector nextDw = next->getR() * next->getAngAcc();
-            const Vector& w = getAngVel();
+            double *nextDw = v3.data();
+            mulRx(next->getR().data(),next->getAngAcc().data(),nextDw);
+            const double *w = getAngVel().data();
             nextDw[0] -= next->getDq()*w[1];
             nextDw[1] += next->getDq()*w[0];
-            setAngAcc(nextDw);
+            setAngAcc(v3);
             //setAngAcc( next->getR() * next->getAngAcc() - next->getDq() * cross(getAngVel(),z0) );
             break;
         }
     case STATIC:
-        setAngAcc(zeros(3));
+        v3.zero();
+        setAngAcc(v3);
         break;
     }
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void OneLinkNewtonEuler::computeLinAcc(OneLinkNewtonEuler *prev)
 {
-    const Matrix& R = getR();
+    const double *R = getR().data();
+    double *temp = v3.data();
     switch(mode)
     {
     case DYNAMIC:
     case DYNAMIC_CORIOLIS_GRAVITY:
     case DYNAMIC_W_ROTOR:
         {
-            const Vector& r = getr(true);
-            Vector temp = prev->getLinAcc()*R;
-            temp += cross(link->dw, r);
-            temp += cross(link->w, cross(link->w, r));
-            setLinAcc(temp);
+            const double *r = getr(true).data();
+            mulxR(prev->getLinAcc().data(),R,temp);
+            addCross3(temp,1.0,link->dw.data(),r);
+            addCrossCross3(temp,1.0,link->w.data(),r);
+            setLinAcc(v3);
             /*setLinAcc( prev->getLinAcc()*R
                 + cross(getAngAcc(), r)
                 + cross(getAngVel(), cross(getAngVel(), r)) );*/
             break;
         }
     case STATIC:
-        setLinAcc( prev->getLinAcc()*R );
+        mulxR(prev->getLinAcc().data(),R,temp);
+        setLinAcc(v3);
         break;
     }
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void OneLinkNewtonEuler::computeLinAccBackward(OneLinkNewtonEuler *next)
 {
-    const Matrix& R = next->getR();
+    const double *R = next->getR().data();
     switch(mode)
     {
     case DYNAMIC:
     case DYNAMIC_CORIOLIS_GRAVITY:
     case DYNAMIC_W_ROTOR:
         {
-            const Vector& r = next->getr(true);
-            Vector temp = next->getLinAcc();
-            temp -= cross(next->getAngAcc(), r);
-            temp -= cross(next->getAngVel(), cross(next->getAngVel(), r));
-            setLinAcc(R*temp);
+            const double *r = next->getr(true).data();
+            const double *nddp = next->getLinAcc().data();
+            double temp[3] = {nddp[0], nddp[1], nddp[2]};
+            addCross3(temp,-1.0,next->getAngAcc().data(),r);
+            addCrossCross3(temp,-1.0,next->getAngVel().data(),r);
+            mulRx(R,temp,v3.data());
+            setLinAcc(v3);
             /*setLinAcc(R * (next->getLinAcc() 
                 - cross(next->getAngAcc(), r) 
                 - cross(next->getAngVel(), cross(next->getAngVel(), r)) ));*/
             break;
         }
     case STATIC:
-        setLinAcc( R * next->getLinAcc() );
+        mulRx(R,next->getLinAcc().data(),v3.data());
+        setLinAcc(v3);
         break;
     }
 }
@@ -547,10 +642,11 @@ void OneLinkNewtonEuler::computeLinAccC()
     case DYNAMIC_CORIOLIS_GRAVITY:
     case DYNAMIC_W_ROTOR:
         {
-            Vector temp = getLinAcc();
-            temp += cross(getAngAcc(),getrC());
-            temp += cross(getAngVel(),cross(getAngVel(),getrC()));
-            setLinAccC(temp);
+            const double *rC = getrC().data();
+            v3 = getLinAcc();
+            addCross3(v3.data(),1.0,getAngAcc().data(),rC);
+            addCrossCross3(v3.data(),1.0,getAngVel().data(),rC);
+            setLinAccC(v3);
             //setLinAccC( getLinAcc() + cross(getAngAcc(),getrC()) + cross(getAngVel(),cross(getAngVel(),getrC())));
             break;
         }
@@ -573,23 +669,31 @@ void OneLinkNewtonEuler::computeAngAccM(OneLinkNewtonEuler *prev)
             + (getKr() * getDq()) * cross(prev->getAngVel(),zm) );
         break;
     case STATIC:
-        setAngAccM(zeros(3)); 
+        v3.zero();
+        setAngAccM(v3); 
         break;
     }
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void OneLinkNewtonEuler::computeForceBackward(OneLinkNewtonEuler *next)
 {
-    Vector temp = next->getMass() * next->getLinAccC();
-    temp += next->getForce();
-    setForce(next->getR() * temp);
+    const double m = next->getMass();
+    const double *nddpC = next->getLinAccC().data();
+    double temp[3] = {m*nddpC[0], m*nddpC[1], m*nddpC[2]};
+    addScaled3(temp,1.0,next->getForce().data());
+    mulRx(next->getR().data(),temp,v3.data());
+    setForce(v3);
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void OneLinkNewtonEuler::computeForceForward(OneLinkNewtonEuler *prev)
 {
-    Vector temp = prev->getForce()*getR();
-    temp -= getMass() * getLinAccC();
-    setForce(temp);
+    double *temp = v3.data();
+    mulxR(prev->getForce().data(),getR().data(),temp);
+    const double m = getMass();
+    const double *ddpC = getLinAccC().data();
+    double f[3] = {m*ddpC[0], m*ddpC[1], m*ddpC[2]};
+    addScaled3(temp,-1.0,f);
+    setForce(v3);
     //setForce( prev->getForce()*getR() - getMass() * getLinAccC() );
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -602,12 +706,16 @@ void OneLinkNewtonEuler::computeMomentBackward(OneLinkNewtonEuler *next)
     case DYNAMIC_CORIOLIS_GRAVITY:
     case DYNAMIC:
         {
-            Vector temp = cross(rnp , next->getForce());
-            temp += cross(rnp + next->getrC() , next->getMass() * next->getLinAccC());
-            temp += next->getMoment(false);
-            temp += next->getInertia() * next->getAngAcc();
-            temp += cross( next->getAngVel() , next->getInertia() * next->getAngVel());
-            setMoment(Rn*temp);
+            const double *nI = next->getInertia().data();
+            const double *nw = next->getAngVel().data();
+            double temp[3];
+            cross3(rnp.data(),next->getForce().data(),temp);
+            addMassMoment3(temp,1.0,rnp.data(),next->getrC().data(),next->getMass(),next->getLinAccC().data());
+            addScaled3(temp,1.0,next->getMoment(false).data());
+            addMul3(temp,1.0,nI,next->getAngAcc().data());
+            addGyro3(temp,1.0,nI,nw);
+            mulRx(Rn.data(),temp,v3.data());
+            setMoment(v3);
             /*setMoment( Rn * ( cross(rnp , next->getForce()) 
                             + cross(rnp + next->getrC() , next->getMass() * next->getLinAccC())
                             + next->getMoment(false)
@@ -627,10 +735,12 @@ void OneLinkNewtonEuler::computeMomentBackward(OneLinkNewtonEuler *next)
         break;
     case STATIC:
         {
-            Vector temp = cross(rnp , next->getForce());
-            temp += cross(rnp + next->getrC() , next->getMass() * next->getLinAccC());
-            temp += next->getMoment(false);
-            setMoment(Rn*temp);
+            double temp[3];
+            cross3(rnp.data(),next->getForce().data(),temp);
+            addMassMoment3(temp,1.0,rnp.data(),next->getrC().data(),next->getMass(),next->getLinAccC().data());
+            addScaled3(temp,1.0,next->getMoment(false).data());
+            mulRx(Rn.data(),temp,v3.data());
+            setMoment(v3);
             /*setMoment( Rn * ( cross(rnp , next->getForce()) 
                         + cross(rnp + next->getrC() , next->getMass() * next->getLinAccC())
                         + next->getMoment(false)));*/
@@ -648,12 +758,14 @@ void OneLinkNewtonEuler::computeMomentForward( OneLinkNewtonEuler *prev)
     case DYNAMIC_CORIOLIS_GRAVITY:
     case DYNAMIC:
         {
-            Vector temp = prev->getMoment(false)*R;
-            temp -= cross(RTr, link->F);
-            temp -= cross(RTr + link->rc, link->m * link->ddpC);
-            temp -= link->I * link->dw;
-            temp -= cross( link->w, link->I * link->w);
-            setMoment(temp);
+            const double *I = link->I.data();
+            double *temp = v3.data();
+            mulxR(prev->getMoment(false).data(),R.data(),temp);
+            addCross3(temp,-1.0,RTr.data(),link->F.data());
+            addMassMoment3(temp,-1.0,RTr.data(),link->rc.data(),link->m,link->ddpC.data());
+            addMul3(temp,-1.0,I,link->dw.data());
+            addGyro3(temp,-1.0,I,link->w.data());
+            setMoment(v3);
             /*setMoment( prev->getMoment(false)*R- cross(RTr, getForce())
                 - cross(RTr + getrC(), getMass() * getLinAccC())
                 - getInertia() * getAngAcc()
@@ -684,10 +796,11 @@ void OneLinkNewtonEuler::computeMomentForward( OneLinkNewtonEuler *prev)
         }
     case STATIC:
         {
-            Vector temp = prev->getMoment(false)*R;
-            temp -= cross(RTr, getForce());
-            temp -= cross(RTr + getrC(), getMass() * getLinAccC());
-            setMoment(temp);
+            double *temp = v3.data();
+            mulxR(prev->getMoment(false).data(),R.data(),temp);
+            addCross3(temp,-1.0,RTr.data(),getForce().data());
+            addMassMoment3(temp,-1.0,RTr.data(),getrC().data(),getMass(),getLinAccC().data());
+            setMoment(v3);
             /*setMoment( prev->getMoment(false)*R - cross(RTr, getForce())
                 - cross(RTr + getrC(), getMass() * getLinAccC()));*/
             break;
@@ -905,7 +1018,12 @@ bool BaseLinkNewtonEuler::setForce(const Vector &_F)
 {
     if(_F.length()==3)
     {
-        F=H0.submatrix(0,2,0,2)*_F;
+        // _F may be the buffer v3 of the recursion
+        double t[3];
+        for(int i=0; i<3; i++)
+            t[i] = H0(i,0)*_F[0]+H0(i,1)*_F[1]+H0(i,2)*_F[2];
+        for(int i=0; i<3; i++)
+            F[i] = t[i];
         return true;
     }
     else
@@ -921,7 +1039,12 @@ bool BaseLinkNewtonEuler::setMoment(const Vector &_Mu)
 {
     if(_Mu.length()==3)
     {
-        Mu = H0.submatrix(0,2,0,2)*_Mu;
+        // _Mu may be the buffer v3 of the recursion
+        double t[3];
+        for(int i=0; i<3; i++)
+            t[i] = H0(i,0)*_Mu[0]+H0(i,1)*_Mu[1]+H0(i,2)*_Mu[2];
+        for(int i=0; i<3; i++)
+            Mu[i] = t[i];
         Mu0 = _Mu;
         return true;
     }
@@ -940,7 +1063,12 @@ bool BaseLinkNewtonEuler::setAngVel(const Vector &_w)
 {
     if(_w.length()==3)
     {
-        w = H0.submatrix(0,2,0,2).transposed()*_w; 
+        // _w may be the buffer v3 of the recursion
+        double t[3];
+        for(int i=0; i<3; i++)
+            t[i] = H0(0,i)*_w[0]+H0(1,i)*_w[1]+H0(2,i)*_w[2];
+        for(int i=0; i<3; i++)
+            w[i] = t[i];
         return true;
     }
     else
@@ -956,7 +1084,12 @@ bool BaseLinkNewtonEuler::setAngAcc(const Vector &_dw)
 {
     if(_dw.length()==3)
     {
-        dw = H0.submatrix(0,2,0,2).transposed()*_dw; 
+        // _dw may be the buffer v3 of the recursion
+        double t[3];
+        for(int i=0; i<3; i++)
+            t[i] = H0(0,i)*_dw[0]+H0(1,i)*_dw[1]+H0(2,i)*_dw[2];
+        for(int i=0; i<3; i++)
+            dw[i] = t[i];
         return true;
     }
     else
@@ -972,7 +1105,12 @@ bool BaseLinkNewtonEuler::setLinAcc(const Vector &_ddp)
 {
     if(_ddp.length()==3)
     {
-        ddp = H0.submatrix(0,2,0,2).transposed()*_ddp; 
+        // _ddp may be the buffer v3 of the recursion
+        double t[3];
+        for(int i=0; i<3; i++)
+            t[i] = H0(0,i)*_ddp[0]+H0(1,i)*_ddp[1]+H0(2,i)*_ddp[2];
+        for(int i=0; i<3; i++)
+            ddp[i] = t[i];
         return true;
     }
     else
@@ -1506,12 +1644,12 @@ bool    SensorLinkNewtonEuler::setAngAccM   (const Vector &_dwM)
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void SensorLinkNewtonEuler::computeAngVel( iDynLink *link)
 {
-    w = link->getW() * R;
+    mulxR(link->getW().data(),R.data(),w.data());
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void SensorLinkNewtonEuler::computeAngAcc( iDynLink *link)
 {
-    dw = link->getdW() * R;
+    mulxR(link->getdW().data(),R.data(),dw.data());
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void SensorLinkNewtonEuler::computeLinAcc( iDynLink *link)
@@ -1521,15 +1659,15 @@ void SensorLinkNewtonEuler::computeLinAcc( iDynLink *link)
     case DYNAMIC:
     case DYNAMIC_CORIOLIS_GRAVITY:
     case DYNAMIC_W_ROTOR:
-        ddp = link->getLinAcc() * R;
-        ddp += cross(dw, r_proj);
-        ddp += cross(w, cross(w, r_proj));
+        mulxR(link->getLinAcc().data(),R.data(),ddp.data());
+        addCross3(ddp.data(),1.0,dw.data(),r_proj.data());
+        addCrossCross3(ddp.data(),1.0,w.data(),r_proj.data());
         /*ddp = getR().transposed() * link->getLinAcc() 
             - cross(dw,getr(true))
             - cross(w,cross(w,getr(true)));*/
         break;
     case STATIC:
-        ddp = getR().transposed() * link->getLinAcc();
+        mulxR(link->getLinAcc().data(),R.data(),ddp.data());
         break;
     }
 }
@@ -1542,8 +1680,8 @@ void SensorLinkNewtonEuler::computeLinAccC()
     case DYNAMIC_CORIOLIS_GRAVITY:
     case DYNAMIC_W_ROTOR:
         ddpC = ddp;
-        ddpC += cross(dw,rc);
-        ddpC += cross(w,cross(w,rc));
+        addCross3(ddpC.data(),1.0,dw.data(),rc.data());
+        addCrossCross3(ddpC.data(),1.0,w.data(),rc.data());
         //ddpC = ddp + cross(dw,rc) + cross(w,cross(w,rc));
         break;
     case STATIC:
@@ -1554,16 +1692,18 @@ void SensorLinkNewtonEuler::computeLinAccC()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void SensorLinkNewtonEuler::computeForce(iDynLink *link)
 {
-    F = link->getForce() * R;
-    F += m * ddpC;
+    mulxR(link->getForce().data(),R.data(),F.data());
+    addScaled3(F.data(),m,ddpC.data());
     //F = getR().transposed() * link->getForce() + m * getLinAccC()  ;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void SensorLinkNewtonEuler::computeForceToLink ( iDynLink *link)
 {
-    Vector temp = F;
-    temp -= m*ddpC;
-    link->setForce(R*temp);
+    double temp[3] = {F[0], F[1], F[2]};
+    double f[3] = {m*ddpC[0], m*ddpC[1], m*ddpC[2]};
+    addScaled3(temp,-1.0,f);
+    mulRx(R.data(),temp,v3.data());
+    link->setForce(v3);
     //link->setForce( R*( F - m * ddpC ) );
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -1574,12 +1714,15 @@ void SensorLinkNewtonEuler::computeMomentToLink( iDynLink *link)
     case DYNAMIC_CORIOLIS_GRAVITY:
     case DYNAMIC:
         {
-            Vector temp = Mu;
-            temp += cross(r_proj, link->getForce()*R);
-            temp -= cross(rc, m*ddpC);
-            temp -= I * (dw);
-            temp -= cross( w , I*(w));
-            link->setMoment(R*temp);
+            double temp[3] = {Mu[0], Mu[1], Mu[2]};
+            double fl[3], f[3] = {m*ddpC[0], m*ddpC[1], m*ddpC[2]};
+            mulxR(link->getForce().data(),R.data(),fl);
+            addCross3(temp,1.0,r_proj.data(),fl);
+            addCross3(temp,-1.0,rc.data(),f);
+            addMul3(temp,-1.0,I.data(),dw.data());
+            addGyro3(temp,-1.0,I.data(),w.data());
+            mulRx(R.data(),temp,v3.data());
+            link->setMoment(v3);
             /*link->setMoment( getR()*( Mu + cross(getr(true),getR().transposed()*link->getForce())
                 - cross(getrC(),(m * getLinAccC()))
                 - getInertia() * getR().transposed() * getAngAcc() 
@@ -1598,10 +1741,13 @@ void SensorLinkNewtonEuler::computeMomentToLink( iDynLink *link)
         break;
     case STATIC:
         {
-            Vector temp = Mu;
-            temp += cross(r_proj, link->getForce()*R);
-            temp -= cross(rc, m*ddpC);
-            link->setMoment(R*temp);
+            double temp[3] = {Mu[0], Mu[1], Mu[2]};
+            double fl[3], f[3] = {m*ddpC[0], m*ddpC[1], m*ddpC[2]};
+            mulxR(link->getForce().data(),R.data(),fl);
+            addCross3(temp,1.0,r_proj.data(),fl);
+            addCross3(temp,-1.0,rc.data(),f);
+            mulRx(R.data(),temp,v3.data());
+            link->setMoment(v3);
             /*link->setMoment( getR() * ( Mu + cross(getr(true),getR().transposed()*link->getForce()) )         
                 - cross(getrC(), m*getLinAccC()) );*/
             break;
@@ -1615,11 +1761,16 @@ void SensorLinkNewtonEuler::computeMoment(iDynLink *link)
     {
     case DYNAMIC_CORIOLIS_GRAVITY:
     case DYNAMIC:
-            Mu = cross(rc, m*ddpC);
-            Mu -= cross(r_proj, link->getForce()*R);
-            Mu += link->getMoment()*R;
-            Mu += I * (dw);
-            Mu += cross( w , I*(w));
+            {
+                double fl[3], f[3] = {m*ddpC[0], m*ddpC[1], m*ddpC[2]};
+                cross3(rc.data(),f,Mu.data());
+                mulxR(link->getForce().data(),R.data(),fl);
+                addCross3(Mu.data(),-1.0,r_proj.data(),fl);
+                mulxR(link->getMoment().data(),R.data(),fl);
+                addScaled3(Mu.data(),1.0,fl);
+                addMul3(Mu.data(),1.0,I.data(),dw.data());
+                addGyro3(Mu.data(),1.0,I.data(),w.data());
+            }
             /*Mu = cross(getrC(),(m * getLinAccC()))
                 - cross(getr(true),getR().transposed()*link->getForce()) 
                 + getR().transposed() * link->getMoment()
@@ -1637,9 +1788,14 @@ void SensorLinkNewtonEuler::computeMoment(iDynLink *link)
 
         break;
     case STATIC:
-        Mu = cross(rc, m*ddpC);
-        Mu -= cross(r_proj, link->getForce()*R);
-        Mu += link->getMoment()*R;
+        {
+            double fl[3], f[3] = {m*ddpC[0], m*ddpC[1], m*ddpC[2]};
+            cross3(rc.data(),f,Mu.data());
+            mulxR(link->getForce().data(),R.data(),fl);
+            addCross3(Mu.data(),-1.0,r_proj.data(),fl);
+            mulxR(link->getMoment().data(),R.data(),fl);
+            addScaled3(Mu.data(),1.0,fl);
+        }
         /*Mu = cross(getrC(), m*getLinAccC()) 
             - cross(getr(true),getR().transposed()*link->getForce()) 
             + getR().transposed() * link->getMoment();*/
@@ -0,0 +1,75 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+// Copyright (C) 2026 Istituto Italiano di Tecnologia - iCub Facility
+// CopyPolicy: Released under the terms of the GNU GPL v2.0.
+
+// Checks that the joint accelerations given by computeForwardDynamics()
+// produce, through the Newton-Euler inverse dynamics, the same torques
+// they were computed from, with a base frame not aligned with gravity.
+
+#include <cmath>
+#include <cstdio>
+
+#include <yarp/sig/Vector.h>
+#include <yarp/sig/Matrix.h>
+#include <yarp/math/Math.h>
+#include <iCub/iDyn/iDyn.h>
+
+using namespace yarp::sig;
+using namespace yarp::math;
+using namespace iCub::iDyn;
+
+int main()
+{
+    iCubArmDyn arm("right");
+    for (unsigned int i=0; i<arm.getN(); i++)
+        arm.releaseLink(i);
+    unsigned int dof=arm.getDOF();
+
+    // tilt the arm base with respect to gravity
+    double a=0.4, b=-0.7;
+    Matrix Rz(4,4), Rx(4,4);
+    Rz.eye(); Rx.eye();
+    Rz(0,0)=cos(a); Rz(0,1)=-sin(a); Rz(1,0)=sin(a); Rz(1,1)=cos(a);
+    Rx(1,1)=cos(b); Rx(1,2)=-sin(b); Rx(2,1)=sin(b); Rx(2,2)=cos(b);
+    Matrix H0=Rz*Rx*arm.getH0();
+    H0(0,3)=0.05; H0(1,3)=-0.02; H0(2,3)=0.1;
+    arm.setH0(H0);
+
+    Vector q(dof), dq(dof), tau(dof);
+    for (unsigned int i=0; i<dof; i++)
+    {
+        q[i]=0.5*(arm(i).getMin()+arm(i).getMax())+0.1*sin(1.0+i);
+        dq[i]=0.3*cos(2.0*i);
+        tau[i]=0.2*sin(3.0*i+0.5);
+    }
+
+    Vector ddp0(3,0.0), zero3(3,0.0);
+    ddp0[2]=9.81;
+
+    Vector ddq=arm.computeForwardDynamics(q,dq,tau,ddp0);
+
+    arm.setAng(q);
+    arm.setDAng(dq);
+    arm.setD2Ang(ddq);
+    arm.prepareNewtonEuler(DYNAMIC);
+    arm.initNewtonEuler(zero3,zero3,ddp0,zero3,zero3);
+    arm.computeNewtonEuler();
+    Vector tauNE=arm.getTorques();
+
+    int ret=0;
+    for (unsigned int i=0; i<dof; i++)
+    {
+        if (fabs(tauNE[i]-tau[i])>1e-6)
+        {
+            fprintf(stderr,"joint %d: tau=%g, inverse dynamics gives %g (ddq=%g)\n",
+                    i,tau[i],tauNE[i],ddq[i]);
+            ret=1;
+        }
+    }
+
+    if (ret==0)
+        fprintf(stdout,"forward and inverse dynamics agree on %d joints\n",dof);
+
+    return ret;
+}
@@ -63,6 +63,7 @@
 
 #include <string>
 #include <deque>
+#include <vector>
 
 #include <yarp/os/Property.h>
 #include <yarp/dev/ControlBoardInterfaces.h>
@@ -81,6 +82,62 @@ namespace iKin
 
 void notImplemented(const unsigned int verbose);
 
+/**
+* \ingroup iKinFwd
+*
+* A fixed-size homogeneous transformation used internally by the 
+* forward kinematics in place of yarp::sig::Matrix. 
+*  
+* Only the upper 3x4 block is stored (row-major in 12 contiguous 
+* doubles), the last row being implicitly [0 0 0 1]; it lives on 
+* the stack or in contiguous buffers and never allocates. 
+*/
+class iKinFrame
+{
+public:
+    double m[12];
+
+    /**
+    * Default constructor: the identity.
+    */
+    iKinFrame() { eye(); }
+
+    /**
+    * Sets the frame to the identity.
+    */
+    void eye();
+
+    /**
+    * Access to the element (r,c) with r<3 and c<4.
+    */
+    double &operator()(const int r, const int c)       { return m[(r<<2)+c]; }
+    double  operator()(const int r, const int c) const { return m[(r<<2)+c]; }
+
+    /**
+    * Copies the upper 3x4 block of a 4x4 yarp::sig::Matrix.
+    * @param H is the 4x4 matrix.
+    */
+    void fromMatrix(const yarp::sig::Matrix &H);
+
+    /**
+    * Fills a 4x4 yarp::sig::Matrix with the frame.
+    * @param H is the destination matrix, resized if needed. 
+    * @param w is the element (3,3), 1 for a rigid transformation 
+    *          and 0 for its derivatives.
+    */
+    void toMatrix(yarp::sig::Matrix &H, const double w=1.0) const;
+
+    /**
+    * Computes out=a*b. 
+    * @param bw is the element (3,3) of b, which is 1 if b is a 
+    *           rigid transformation and 0 if it is a derivative
+    *           of it.
+    * \note out shall not be a nor b.
+    */
+    static void multiply(const iKinFrame &a, const iKinFrame &b,
+                         iKinFrame &out, const double bw=1.0);
+};
+
 /**
 * \ingroup iKinFwd
 *
@@ -120,6 +177,7 @@ protected:
     iKinLink();
 
     virtual void clone(const iKinLink &l);    
+    void         computeFrame(iKinFrame &F, const unsigned int n=0) const;
     bool         isCumulative()     { return cumulative;          }
     void         block()            { blocked=true;               }
     void         block(double _Ang) { setAng(_Ang); blocked=true; }
@@ -354,6 +412,8 @@ public:
 };
 
 
+class iKinBatchWorker;
+
 /**
 * \ingroup iKinFwd
 *
@@ -378,6 +438,32 @@ protected:
     yarp::sig::Matrix hess_J;
     yarp::sig::Matrix hess_Jlnk;
 
+    // fkFrames[i] is the frame of the base of the i-th link (H0 for 
+    // i=0) and fkLinks[i] the transformation of the i-th link, both 
+    // computed over allList by forwardSweep(); fkSuffix[i] is the 
+    // product of the transformations from the i-th link on. 
+    std::vector<iKinFrame> fkFrames;
+    std::vector<iKinFrame> fkLinks;
+    std::vector<iKinFrame> fkSuffix;
+
+    // when fkCaching is on, the first fkValid entries of fkLinks and 
+    // fkFrames are reused as long as H0 and the parameters of the 
+    // links they were computed with (fkParams) do not change 
+    bool                fkCaching;
+    unsigned int        fkValid;
+    std::vector<double> fkParams;
+
+    void forwardSweep(const unsigned int n);
+    void backwardSweep(const unsigned int n, const bool withHN);
+    void dRotAng(const iKinFrame &R, const iKinFrame &dR, double *dr);
+    void batchKinematics(const yarp::sig::Matrix &Q, const unsigned int start,
+                         const unsigned int end, yarp::sig::Matrix &poses,
+                         std::deque<yarp::sig::Matrix> *J, const bool axisRep) const;
+
+    friend class iKinBatchWorker;
+    void geoJacobianColumn(const iKinFrame &Z, const iKinFrame &PN,
+                           yarp::sig::Matrix &J, const unsigned int col);
+
     virtual void clone(const iKinChain &c);
     virtual void build();
     virtual void dispose();
@@ -536,6 +622,25 @@ public:
     */
     void setAllLinkVerbosity(unsigned int _verbose);
 
+    /**
+    * Enables/disables the caching of the forward kinematics. 
+    *  
+    * When enabled, the frames of the links are recomputed only 
+    * from the first link whose joint angle or parameters have 
+    * changed since the last query, so that several calls to 
+    * getH(), Pose(), GeoJacobian(), Hessian_ij()... at the same 
+    * configuration share the same computation. 
+    * @param _caching true to enable the cache (disabled by 
+    *                 default).
+    */
+    void setCaching(const bool _caching);
+
+    /**
+    * Returns the status of the forward kinematics cache. 
+    * @return true if enabled. 
+    */
+    bool getCaching() const { return fkCaching; }
+
     /**
     * Sets the verbosity level of the Chain.
     * @param _verbose is a integer number which progressively 
@@ -759,6 +864,31 @@ public:
     */
     yarp::sig::Matrix GeoJacobian(const yarp::sig::Vector &q);
 
+    /**
+    * Computes the end-effector poses and optionally the geometric 
+    * Jacobians over a set of configurations, without altering the 
+    * current state of the Chain. 
+    *  
+    * The configurations are processed in blocks whose frames are 
+    * stored as structure of arrays, so that the products are 
+    * vectorized across configurations, and the blocks can be 
+    * spread over several threads. 
+    * @param Q is the NxDOF matrix of configurations, one per row; 
+    *          the same joint constraints of setAng() are applied.
+    * @param poses is the Nx7 (axis/angle) or Nx6 (Euler angles) 
+    *              matrix of the resulting end-effector poses.
+    * @param J if not NULL, is filled with the N 6xDOF geometric 
+    *          Jacobians.
+    * @param axisRep if true returns the axis/angle notation.
+    * @param nThreads is the number of threads to be used (1 by 
+    *                 default, i.e. the caller's thread).
+    * @return true/false on success/failure. 
+    * @note The blocked links are not considered.
+    */
+    bool EndEffPose(const yarp::sig::Matrix &Q, yarp::sig::Matrix &poses,
+                    std::deque<yarp::sig::Matrix> *J=NULL, const bool axisRep=true,
+                    const unsigned int nThreads=1) const;
+
     /**
     * Returns the 6x1 vector \f$ 
     * \partial{^2}F\left(q\right)/\partial q_i \partial q_j, \f$
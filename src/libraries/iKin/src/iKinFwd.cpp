@@ -22,6 +22,7 @@
 #include <algorithm>
 
 #include <yarp/os/Log.h>
+#include <yarp/os/Thread.h>
 
 #include <iCub/iKin/iKinFwd.h>
 
@@ -33,6 +34,42 @@ using namespace yarp::math;
 using namespace iCub::ctrl;
 using namespace iCub::iKin;
 
+// number of configurations processed side by side by
+// iKinChain::EndEffPose(const Matrix&,...)
+#define IKIN_BATCH_LANES    4
+
+namespace iCub
+{
+
+namespace iKin
+{
+
+class iKinBatchWorker : public Thread
+{
+    const iKinChain &chain;
+    const Matrix &Q;
+    Matrix &poses;
+    deque<Matrix> *J;
+    bool axisRep;
+    unsigned int start,end;
+
+public:
+    iKinBatchWorker(const iKinChain &_chain, const Matrix &_Q, Matrix &_poses,
+                    deque<Matrix> *_J, const bool _axisRep,
+                    const unsigned int _start, const unsigned int _end) :
+                    chain(_chain), Q(_Q), poses(_poses), J(_J), axisRep(_axisRep),
+                    start(_start), end(_end) { }
+
+    void run()
+    {
+        chain.batchKinematics(Q,start,end,poses,J,axisRep);
+    }
+};
+
+}
+
+}
+
 
 /************************************************************************/
 void iCub::iKin::notImplemented(const unsigned int verbose)
@@ -42,6 +79,60 @@ void iCub::iKin::notImplemented(const unsigned int verbose)
 }
 
 
+/************************************************************************/
+void iKinFrame::eye()
+{
+    for (int i=0; i<12; i++)
+        m[i]=0.0;
+
+    m[0]=m[5]=m[10]=1.0;
+}
+
+
+/************************************************************************/
+void iKinFrame::fromMatrix(const Matrix &H)
+{
+    for (int r=0; r<3; r++)
+        for (int c=0; c<4; c++)
+            m[(r<<2)+c]=H(r,c);
+}
+
+
+/************************************************************************/
+void iKinFrame::toMatrix(Matrix &H, const double w) const
+{
+    if ((H.rows()!=4) || (H.cols()!=4))
+        H.resize(4,4);
+
+    for (int r=0; r<3; r++)
+        for (int c=0; c<4; c++)
+            H(r,c)=m[(r<<2)+c];
+
+    H(3,0)=H(3,1)=H(3,2)=0.0;
+    H(3,3)=w;
+}
+
+
+/************************************************************************/
+void iKinFrame::multiply(const iKinFrame &a, const iKinFrame &b,
+                         iKinFrame &out, const double bw)
+{
+    const double *A=a.m;
+    const double *B=b.m;
+    double *O=out.m;
+
+    // fixed trip counts over contiguous rows: the compiler unrolls
+    // and vectorizes the inner loop
+    for (int r=0; r<3; r++, A+=4, O+=4)
+    {
+        for (int c=0; c<4; c++)
+            O[c]=A[0]*B[c]+A[1]*B[4+c]+A[2]*B[8+c];
+
+        O[3]+=A[3]*bw;
+    }
+}
+
+
 /************************************************************************/
 iKinLink::iKinLink(double _A, double _D, double _Alpha, double _Offset,
                    double _Min, double _Max): zeros1x1(zeros(1,1)), zeros1(zeros(1))
@@ -251,6 +342,41 @@ Matrix iKinLink::getDnH(unsigned int n, bool c_override)
 }
 
 
+/************************************************************************/
+void iKinLink::computeFrame(iKinFrame &F, const unsigned int n) const
+{
+    double theta=Ang+Offset;
+    double c_theta=cos(theta);
+    double s_theta=sin(theta);
+    double *m=F.m;
+
+    if (n==0)
+    {
+        m[0]=c_theta; m[1]=-s_theta*c_alpha; m[2] =s_theta*s_alpha;  m[3] =c_theta*A;
+        m[4]=s_theta; m[5]=c_theta*c_alpha;  m[6] =-c_theta*s_alpha; m[7] =s_theta*A;
+        m[8]=0.0;     m[9]=s_alpha;          m[10]=c_alpha;          m[11]=D;
+    }
+    else
+    {
+        // same as getDnH(): the last two rows vanish
+        double C=(n>>1)&1 ? -1.0 : 1.0;
+
+        if (n&1)
+        {
+            m[0]=-C*s_theta; m[1]=-C*c_theta*c_alpha; m[2]=C*c_theta*s_alpha; m[3]=-C*s_theta*A;
+            m[4]=C*c_theta;  m[5]=-C*s_theta*c_alpha; m[6]=C*s_theta*s_alpha; m[7]=C*c_theta*A;
+        }
+        else
+        {
+            m[0]=C*c_theta;  m[1]=-C*s_theta*c_alpha; m[2]=C*s_theta*s_alpha;  m[3]=C*c_theta*A;
+            m[4]=C*s_theta;  m[5]=C*c_theta*c_alpha;  m[6]=-C*c_theta*s_alpha; m[7]=C*s_theta*A;
+        }
+
+        m[8]=m[9]=m[10]=m[11]=0.0;
+    }
+}
+
+
 /************************************************************************/
 void iKinLink::addCumH(const Matrix &_cumH)
 {
@@ -264,6 +390,9 @@ iKinChain::iKinChain()
 {
     N=DOF=verbose=0;
     H0=HN=eye(4,4);
+
+    fkCaching=false;
+    fkValid=0;
 }
 
 
@@ -278,6 +407,12 @@ void iKinChain::clone(const iKinChain &c)
     verbose  =c.verbose;
     hess_J   =c.hess_J;
     hess_Jlnk=c.hess_Jlnk;
+    fkFrames =c.fkFrames;
+    fkLinks  =c.fkLinks;
+    fkSuffix =c.fkSuffix;
+    fkParams =c.fkParams;
+    fkCaching=c.fkCaching;
+    fkValid  =0;
 
     allList.assign(c.allList.begin(),c.allList.end());
     quickList.assign(c.quickList.begin(),c.quickList.end());
@@ -366,6 +501,12 @@ void iKinChain::clear()
 
     N=DOF=0;
     H0=HN=eye(4,4);
+
+    fkFrames.resize(1);
+    fkLinks.clear();
+    fkSuffix.resize(1);
+    fkParams.clear();
+    fkValid=0;
 }
 
 
@@ -562,6 +703,110 @@ void iKinChain::build()
 
     if (DOF>0)
         curr_q.resize(DOF,0);
+
+    fkFrames.resize(N+1);
+    fkLinks.resize(N);
+    fkSuffix.resize(N+1);
+    fkParams.resize(5*N);
+    fkValid=0;
+}
+
+
+/************************************************************************/
+void iKinChain::setCaching(const bool _caching)
+{
+    fkCaching=_caching;
+    fkValid=0;
+}
+
+
+/************************************************************************/
+void iKinChain::forwardSweep(const unsigned int n)
+{
+    if (fkFrames.size()<n+1)
+    {
+        fkFrames.resize(n+1);
+        fkLinks.resize(n);
+        fkSuffix.resize(n+1);
+        fkParams.resize(5*n);
+        fkValid=0;
+    }
+
+    unsigned int first=0;
+    if (fkCaching)
+    {
+        iKinFrame _H0;
+        _H0.fromMatrix(H0);
+
+        bool sameH0=true;
+        for (int k=0; k<12; k++)
+        {
+            if (_H0.m[k]!=fkFrames[0].m[k])
+            {
+                sameH0=false;
+                break;
+            }
+        }
+
+        if (sameH0)
+        {
+            // look for the first link changed since it was computed
+            unsigned int valid=std::min(fkValid,n);
+            for (; first<valid; first++)
+            {
+                const iKinLink *l=allList[first];
+                const double *p=&fkParams[5*first];
+                if ((p[0]!=l->Ang) || (p[1]!=l->A) || (p[2]!=l->D) ||
+                    (p[3]!=l->Alpha) || (p[4]!=l->Offset))
+                    break;
+            }
+
+            // no change in the requested part: what lies beyond is
+            // still valid too
+            if (first==valid)
+            {
+                if (fkValid<n)
+                    fkValid=n;
+            }
+            else
+                fkValid=n;
+        }
+        else
+        {
+            fkFrames[0]=_H0;
+            fkValid=n;
+        }
+    }
+    else
+        fkFrames[0].fromMatrix(H0);
+
+    for (unsigned int i=first; i<n; i++)
+    {
+        const iKinLink *l=allList[i];
+        l->computeFrame(fkLinks[i]);
+        iKinFrame::multiply(fkFrames[i],fkLinks[i],fkFrames[i+1]);
+
+        double *p=&fkParams[5*i];
+        p[0]=l->Ang;
+        p[1]=l->A;
+        p[2]=l->D;
+        p[3]=l->Alpha;
+        p[4]=l->Offset;
+    }
+}
+
+
+/************************************************************************/
+void iKinChain::backwardSweep(const unsigned int n, const bool withHN)
+{
+    // relies on fkLinks filled by forwardSweep(n)
+    if (withHN)
+        fkSuffix[n].fromMatrix(HN);
+    else
+        fkSuffix[n].eye();
+
+    for (int i=n-1; i>=0; i--)
+        iKinFrame::multiply(fkLinks[i],fkSuffix[i+1],fkSuffix[i]);
 }
 
 
@@ -736,46 +981,53 @@ Vector iKinChain::d2RotAng(const Matrix &R, const Matrix &dRi,
 
 
 /************************************************************************/
-Matrix iKinChain::getH(const unsigned int i, const bool allLink)
+void iKinChain::dRotAng(const iKinFrame &R, const iKinFrame &dR, double *dr)
 {
-    Matrix H=H0;
-    unsigned int _i,n;
-    deque<iKinLink*> *l;
-    bool cumulHN=false;
-    bool c_override;
+    dr[0]=(R(2,1)*dR(2,2) - R(2,2)*dR(2,1)) / (R(2,1)*R(2,1) + R(2,2)*R(2,2));
+    dr[1]=dR(2,0)/sqrt(fabs(1-R(2,0)*R(2,0)));
+    dr[2]=(R(1,0)*dR(0,0) - R(0,0)*dR(1,0)) / (R(1,0)*R(1,0) + R(0,0)*R(0,0));
+}
 
-    if (allLink)
-    {
-        n=N;
-        l=&allList;
-        c_override=true;
 
-        _i=i;
-        if (_i>=N-1)
-            cumulHN=true;
-    }
-    else
-    {
-        n=DOF;
-        l=&quickList;
-        c_override=false;
+/************************************************************************/
+void iKinChain::geoJacobianColumn(const iKinFrame &Z, const iKinFrame &PN,
+                                  Matrix &J, const unsigned int col)
+{
+    // z-axis of Z crossed with the distance from Z to PN
+    double dx=PN(0,3)-Z(0,3);
+    double dy=PN(1,3)-Z(1,3);
+    double dz=PN(2,3)-Z(2,3);
 
-        if (i==DOF)
-            _i=quickList.size();
-        else
-            _i=i;
+    J(0,col)=Z(1,2)*dz-Z(2,2)*dy;
+    J(1,col)=Z(2,2)*dx-Z(0,2)*dz;
+    J(2,col)=Z(0,2)*dy-Z(1,2)*dx;
+    J(3,col)=Z(0,2);
+    J(4,col)=Z(1,2);
+    J(5,col)=Z(2,2);
+}
 
-        if (hash[_i]>=N-1)
-            cumulHN=true;
-    }
 
+/************************************************************************/
+Matrix iKinChain::getH(const unsigned int i, const bool allLink)
+{
+    unsigned int n=allLink ? N : DOF;
     yAssert(i<n);
 
-    for (unsigned int j=0; j<=_i; j++)
-        H*=((*l)[j]->getH(c_override));
+    // the product over quickList up to the i-th dof, cumulative
+    // links included, equals the one over allList up to its link
+    unsigned int lnk=allLink ? i : hash[i];
+    forwardSweep(lnk+1);
 
-    if (cumulHN)
-        H*=HN;
+    Matrix H;
+    if (lnk>=N-1)
+    {
+        iKinFrame _HN,F;
+        _HN.fromMatrix(HN);
+        iKinFrame::multiply(fkFrames[lnk+1],_HN,F);
+        F.toMatrix(H);
+    }
+    else
+        fkFrames[lnk+1].toMatrix(H);
 
     return H;
 }
@@ -784,15 +1036,16 @@ Matrix iKinChain::getH(const unsigned int i, const bool allLink)
 /************************************************************************/
 Matrix iKinChain::getH()
 {
-    // may be different from DOF since one blocked link may lie
-    // at the end of the chain.
-    unsigned int n=quickList.size();
-    Matrix H=H0;
+    forwardSweep(N);
 
-    for (unsigned int i=0; i<n; i++)
-        H*=quickList[i]->getH();
+    iKinFrame _HN,F;
+    _HN.fromMatrix(HN);
+    iKinFrame::multiply(fkFrames[N],_HN,F);
 
-    return H*HN;
+    Matrix H;
+    F.toMatrix(H);
+
+    return H;
 }
 
 
@@ -849,7 +1102,23 @@ Vector iKinChain::Pose(const unsigned int i, const bool axisRep)
 Vector iKinChain::Position(const unsigned int i)
 {
     yAssert(i<N);
-    return getH(i,true).subcol(0,3,3);
+
+    forwardSweep(i+1);
+
+    iKinFrame F=fkFrames[i+1];
+    if (i>=N-1)
+    {
+        iKinFrame _HN;
+        _HN.fromMatrix(HN);
+        iKinFrame::multiply(fkFrames[i+1],_HN,F);
+    }
+
+    Vector p(3);
+    p[0]=F(0,3);
+    p[1]=F(1,3);
+    p[2]=F(2,3);
+
+    return p;
 }
 
 
@@ -900,7 +1169,18 @@ Vector iKinChain::EndEffPose(const Vector &q, const bool axisRep)
 /************************************************************************/
 Vector iKinChain::EndEffPosition()
 {
-    return getH().subcol(0,3,3);
+    forwardSweep(N);
+
+    iKinFrame _HN,F;
+    _HN.fromMatrix(HN);
+    iKinFrame::multiply(fkFrames[N],_HN,F);
+
+    Vector p(3);
+    p[0]=F(0,3);
+    p[1]=F(1,3);
+    p[2]=F(2,3);
+
+    return p;
 }
 
 
@@ -921,32 +1201,23 @@ Matrix iKinChain::AnaJacobian(const unsigned int i, unsigned int col)
 
     col=col>3 ? 3 : col;
 
+    // dH/dq_j=fkFrames[j]*dA_j*fkSuffix[j+1]: one sweep per side
+    // instead of one chain product per column
+    forwardSweep(i+1);
+    backwardSweep(i+1,i>=N-1);
+
     Matrix J(6,i+1);
-    Matrix H,dH,_H;
-    Vector dr;
+    iKinFrame H,dA,T,dH;
+    double dr[3];
+
+    iKinFrame::multiply(fkFrames[0],fkSuffix[0],H);
 
     for (unsigned int j=0; j<=i; j++)
     {
-        H=dH=H0;
-
-        for (unsigned int k=0; k<=i; k++)
-        {
-            _H=allList[k]->getH(true);
-            H*=_H;
-
-            if (j==k)
-                dH*=allList[k]->getDnH(1,true);
-            else
-                dH*=_H;
-        }
-
-        if (i>=N-1)
-        {
-            H*=HN;
-            dH*=HN;
-        }
-
-        dr=dRotAng(H,dH);
+        allList[j]->computeFrame(dA,1);
+        iKinFrame::multiply(dA,fkSuffix[j+1],T);
+        iKinFrame::multiply(fkFrames[j],T,dH,0.0);
+        dRotAng(H,dH,dr);
 
         J(0,j)=dH(0,col);
         J(1,j)=dH(1,col);
@@ -967,31 +1238,23 @@ Matrix iKinChain::AnaJacobian(unsigned int col)
 
     col=col>3 ? 3 : col;
 
-    // may be different from DOF since one blocked link may lie
-    // at the end of the chain.
-    unsigned int n=quickList.size();
+    forwardSweep(N);
+    backwardSweep(N,true);
+
     Matrix J(6,DOF);
-    Matrix H,dH,_H;
-    Vector dr;
+    iKinFrame H,dA,T,dH;
+    double dr[3];
+
+    iKinFrame::multiply(fkFrames[0],fkSuffix[0],H);
 
     for (unsigned int i=0; i<DOF; i++)
     {
-        H=dH=H0;
-
-        for (unsigned int j=0; j<n; j++)
-        {
-            _H=quickList[j]->getH();
-            H*=_H;
-
-            if (hash_dof[i]==j)
-                dH*=quickList[j]->getDnH();
-            else
-                dH*=_H;
-        }
+        unsigned int j=hash[i];
 
-        H*=HN;
-        dH*=HN;
-        dr=dRotAng(H,dH);
+        allList[j]->computeFrame(dA,1);
+        iKinFrame::multiply(dA,fkSuffix[j+1],T);
+        iKinFrame::multiply(fkFrames[j],T,dH,0.0);
+        dRotAng(H,dH,dr);
 
         J(0,i)=dH(0,col);
         J(1,i)=dH(1,col);
@@ -1020,33 +1283,20 @@ Matrix iKinChain::GeoJacobian(const unsigned int i)
 {
     yAssert(i<N);
 
-    Matrix J(6,i+1);
-    Matrix PN,Z;
-    Vector w;
-
-    deque<Matrix> intH;
-    intH.push_back(H0);
-
-    for (unsigned int j=0; j<=i; j++)
-        intH.push_back(intH[j]*allList[j]->getH(true));
+    forwardSweep(i+1);
 
-    PN=intH[i+1];
+    iKinFrame PN=fkFrames[i+1];
     if (i>=N-1)
-        PN=PN*HN;
-
-    for (unsigned int j=0; j<=i; j++)
     {
-        Z=intH[j];
-        w=cross(Z,2,PN-Z,3);
-
-        J(0,j)=w[0];
-        J(1,j)=w[1];
-        J(2,j)=w[2];
-        J(3,j)=Z(0,2);
-        J(4,j)=Z(1,2);
-        J(5,j)=Z(2,2);
+        iKinFrame _HN;
+        _HN.fromMatrix(HN);
+        iKinFrame::multiply(fkFrames[i+1],_HN,PN);
     }
 
+    Matrix J(6,i+1);
+    for (unsigned int j=0; j<=i; j++)
+        geoJacobianColumn(fkFrames[j],PN,J,j);
+
     return J;
 }
 
@@ -1056,32 +1306,15 @@ Matrix iKinChain::GeoJacobian()
 {
     yAssert(DOF>0);
 
-    Matrix J(6,DOF);
-    Matrix PN,Z;
-    Vector w;
+    forwardSweep(N);
 
-    deque<Matrix> intH;
-    intH.push_back(H0);
-
-    for (unsigned int i=0; i<N; i++)
-        intH.push_back(intH[i]*allList[i]->getH(true));
-
-    PN=intH[N]*HN;
+    iKinFrame _HN,PN;
+    _HN.fromMatrix(HN);
+    iKinFrame::multiply(fkFrames[N],_HN,PN);
 
+    Matrix J(6,DOF);
     for (unsigned int i=0; i<DOF; i++)
-    {
-        unsigned int j=hash[i];
-
-        Z=intH[j];
-        w=cross(Z,2,PN-Z,3);
-
-        J(0,i)=w[0];
-        J(1,i)=w[1];
-        J(2,i)=w[2];
-        J(3,i)=Z(0,2);
-        J(4,i)=Z(1,2);
-        J(5,i)=Z(2,2);
-    }
+        geoJacobianColumn(fkFrames[hash[i]],PN,J,i);
 
     return J;
 }
@@ -1097,6 +1330,204 @@ Matrix iKinChain::GeoJacobian(const Vector &q)
 }
 
 
+/************************************************************************/
+void iKinChain::batchKinematics(const Matrix &Q, const unsigned int start,
+                                const unsigned int end, Matrix &poses,
+                                deque<Matrix> *J, const bool axisRep) const
+{
+    const unsigned int L=IKIN_BATCH_LANES;
+
+    // frames[(i*12+k)*L+b] is the element k of the base frame of the
+    // i-th link for the lane b: each operation spans L contiguous lanes
+    vector<double> frames((N+1)*12*L);
+    double lnk[12*L];
+    double ang[L];
+
+    iKinFrame _H0,_HN;
+    _H0.fromMatrix(H0);
+    _HN.fromMatrix(HN);
+
+    for (unsigned int k=0; k<12; k++)
+        for (unsigned int b=0; b<L; b++)
+            frames[k*L+b]=_H0.m[k];
+
+    Matrix H(4,4);
+    H.eye();
+
+    for (unsigned int r0=start; r0<end; r0+=L)
+    {
+        // the last block is padded repeating its last configuration
+        unsigned int nLanes=std::min(L,end-r0);
+
+        for (unsigned int i=0,dof=0; i<N; i++)
+        {
+            const iKinLink *l=allList[i];
+            bool active=!l->blocked;
+
+            for (unsigned int b=0; b<L; b++)
+            {
+                double a=l->Ang;
+                if (active)
+                {
+                    a=Q(r0+std::min(b,nLanes-1),dof);
+                    if (l->constrained)
+                        a=(a<l->Min) ? l->Min : ((a>l->Max) ? l->Max : a);
+                }
+                ang[b]=a;
+            }
+
+            if (active)
+                dof++;
+
+            for (unsigned int b=0; b<L; b++)
+            {
+                double theta=ang[b]+l->Offset;
+                double c_theta=cos(theta);
+                double s_theta=sin(theta);
+
+                lnk[0*L+b]=c_theta;  lnk[1*L+b]=-s_theta*l->c_alpha; lnk[2*L+b] =s_theta*l->s_alpha;  lnk[3*L+b] =c_theta*l->A;
+                lnk[4*L+b]=s_theta;  lnk[5*L+b]=c_theta*l->c_alpha;  lnk[6*L+b] =-c_theta*l->s_alpha; lnk[7*L+b] =s_theta*l->A;
+                lnk[8*L+b]=0.0;      lnk[9*L+b]=l->s_alpha;          lnk[10*L+b]=l->c_alpha;          lnk[11*L+b]=l->D;
+            }
+
+            const double *F=&frames[i*12*L];
+            double *O=&frames[(i+1)*12*L];
+            for (unsigned int row=0; row<3; row++)
+            {
+                const double *a0=&F[(row*4+0)*L];
+                const double *a1=&F[(row*4+1)*L];
+                const double *a2=&F[(row*4+2)*L];
+                const double *a3=&F[(row*4+3)*L];
+
+                for (unsigned int c=0; c<4; c++)
+                {
+                    double *o=&O[(row*4+c)*L];
+                    const double *b0=&lnk[(0*4+c)*L];
+                    const double *b1=&lnk[(1*4+c)*L];
+                    const double *b2=&lnk[(2*4+c)*L];
+
+                    for (unsigned int b=0; b<L; b++)
+                        o[b]=a0[b]*b0[b]+a1[b]*b1[b]+a2[b]*b2[b];
+                }
+
+                double *o=&O[(row*4+3)*L];
+                for (unsigned int b=0; b<L; b++)
+                    o[b]+=a3[b];
+            }
+        }
+
+        // back to the AoS layout, one configuration at a time
+        for (unsigned int b=0; b<nLanes; b++)
+        {
+            unsigned int r=r0+b;
+            iKinFrame FN,PN;
+            for (unsigned int k=0; k<12; k++)
+                FN.m[k]=frames[(N*12+k)*L+b];
+            iKinFrame::multiply(FN,_HN,PN);
+
+            poses(r,0)=PN(0,3);
+            poses(r,1)=PN(1,3);
+            poses(r,2)=PN(2,3);
+
+            if (axisRep)
+            {
+                PN.toMatrix(H);
+                Vector v=dcm2axis(H);
+                poses(r,3)=v[0];
+                poses(r,4)=v[1];
+                poses(r,5)=v[2];
+                poses(r,6)=v[3];
+            }
+            else
+            {
+                // Euler Angles as XYZ (see RotAng())
+                poses(r,3)=atan2(-PN(2,1),PN(2,2));
+                poses(r,4)=asin(PN(2,0));
+                poses(r,5)=atan2(-PN(1,0),PN(0,0));
+            }
+
+            if (J!=NULL)
+            {
+                Matrix &Jr=(*J)[r];
+                Jr.resize(6,DOF);
+
+                for (unsigned int i=0; i<DOF; i++)
+                {
+                    const double *Z=&frames[hash[i]*12*L+b];
+                    double zx=Z[2*L],zy=Z[6*L],zz=Z[10*L];
+                    double dx=PN(0,3)-Z[3*L];
+                    double dy=PN(1,3)-Z[7*L];
+                    double dz=PN(2,3)-Z[11*L];
+
+                    Jr(0,i)=zy*dz-zz*dy;
+                    Jr(1,i)=zz*dx-zx*dz;
+                    Jr(2,i)=zx*dy-zy*dx;
+                    Jr(3,i)=zx;
+                    Jr(4,i)=zy;
+                    Jr(5,i)=zz;
+                }
+            }
+        }
+    }
+}
+
+
+/************************************************************************/
+bool iKinChain::EndEffPose(const Matrix &Q, Matrix &poses, deque<Matrix> *J,
+                           const bool axisRep, const unsigned int nThreads) const
+{
+    if ((DOF==0) || ((unsigned int)Q.cols()!=DOF))
+    {
+        if (verbose)
+            yError("EndEffPose() failed since the configurations are not %d-dimensional",DOF);
+
+        return false;
+    }
+
+    unsigned int n=Q.rows();
+    poses.resize(n,axisRep?7:6);
+    if (J!=NULL)
+        J->resize(n);
+
+    if (n==0)
+        return true;
+
+    // split in chunks made of whole blocks of lanes
+    unsigned int nBlocks=(n+IKIN_BATCH_LANES-1)/IKIN_BATCH_LANES;
+    unsigned int nWorkers=std::max(1U,std::min(nThreads,nBlocks));
+
+    if (nWorkers==1)
+    {
+        batchKinematics(Q,0,n,poses,J,axisRep);
+        return true;
+    }
+
+    unsigned int chunk=IKIN_BATCH_LANES*((nBlocks+nWorkers-1)/nWorkers);
+    deque<iKinBatchWorker*> workers;
+    for (unsigned int start=0; start<n; start+=chunk)
+    {
+        iKinBatchWorker *w=new iKinBatchWorker(*this,Q,poses,J,axisRep,
+                                               start,std::min(n,start+chunk));
+        workers.push_back(w);
+    }
+
+    // the caller's thread takes care of the first chunk
+    for (size_t i=1; i<workers.size(); i++)
+        workers[i]->start();
+
+    workers[0]->run();
+
+    for (size_t i=0; i<workers.size(); i++)
+    {
+        if (i>0)
+            workers[i]->stop();
+        delete workers[i];
+    }
+
+    return true;
+}
+
+
 /************************************************************************/
 Vector iKinChain::Hessian_ij(const unsigned int i, const unsigned int j)
 {
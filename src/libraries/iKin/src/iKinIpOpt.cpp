@@ -1040,8 +1040,15 @@ yarp::sig::Vector iKinIpOptMin::solve(const yarp::sig::Vector &q0, yarp::sig::Ve
     nlp->set_posePriority(posePriority);
     nlp->set_callback(iterate);
 
+    // IpOpt evaluates cost, gradient and hessian at the same q, hence
+    // the caching pays off; the user's setting is restored afterwards
+    bool caching=chain.getCaching();
+    chain.setCaching(true);
+
     ApplicationReturnStatus status=CAST_IPOPTAPP(App)->OptimizeTNLP(GetRawPtr(nlp));
 
+    chain.setCaching(caching);
+
     if (exit_code!=NULL)
         *exit_code=status;
 
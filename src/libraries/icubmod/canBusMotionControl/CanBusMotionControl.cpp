@@ -4555,22 +4555,41 @@ bool CanBusMotionControl::getPidsRaw (Pid *out)
 {
     CanBusResources& r = RES(system_resources);
 
-    int i;
-    for (i = 0; i < r.getJoints(); i++)
+    // the gains of all the joints are asked with a single batch of messages
+    const int msgs[] = { ICUBCANPROTO_POL_MC_CMD__GET_P_GAIN, ICUBCANPROTO_POL_MC_CMD__GET_D_GAIN,
+                         ICUBCANPROTO_POL_MC_CMD__GET_I_GAIN, ICUBCANPROTO_POL_MC_CMD__GET_ILIM_GAIN,
+                         ICUBCANPROTO_POL_MC_CMD__GET_OFFSET, ICUBCANPROTO_POL_MC_CMD__GET_SCALE,
+                         ICUBCANPROTO_POL_MC_CMD__GET_TLIM, ICUBCANPROTO_POL_MC_CMD__GET_POS_STICTION_PARAMS };
+    const int nmsgs = sizeof(msgs)/sizeof(msgs[0]);
+    const int nj = r.getJoints();
+
+    std::vector<CanReadRequest> requests(nj*nmsgs);
+    for (int i = 0; i < nj; i++)
+    {
+        for (int k = 0; k < nmsgs; k++)
+        {
+            requests[i*nmsgs+k].msg = msgs[k];
+            requests[i*nmsgs+k].axis = i;
+        }
+    }
+
+    bool ret = _readBatch(&requests[0], nj*nmsgs);
+
+    for (int i = 0; i < nj; i++)
     {
-        short s;
-        short s2;
-        _readWord16 (ICUBCANPROTO_POL_MC_CMD__GET_P_GAIN, i, s); out[i].kp = double(s);
-        _readWord16 (ICUBCANPROTO_POL_MC_CMD__GET_D_GAIN, i, s); out[i].kd = double(s);
-        _readWord16 (ICUBCANPROTO_POL_MC_CMD__GET_I_GAIN, i, s); out[i].ki = double(s);
-        _readWord16 (ICUBCANPROTO_POL_MC_CMD__GET_ILIM_GAIN, i, s); out[i].max_int = double(s);
-        _readWord16 (ICUBCANPROTO_POL_MC_CMD__GET_OFFSET, i, s); out[i].offset= double(s);
-        _readWord16 (ICUBCANPROTO_POL_MC_CMD__GET_SCALE, i, s); out[i].scale = double(s);
-        _readWord16 (ICUBCANPROTO_POL_MC_CMD__GET_TLIM, i, s); out[i].max_output = double(s);
-        _readWord16Ex (ICUBCANPROTO_POL_MC_CMD__GET_POS_STICTION_PARAMS, i, s, s2 ); out[i].stiction_up_val = double(s); out[i].stiction_down_val = double(s2);
+        const CanReadRequest *q = &requests[i*nmsgs];
+        out[i].kp = double(q[0].word16());
+        out[i].kd = double(q[1].word16());
+        out[i].ki = double(q[2].word16());
+        out[i].max_int = double(q[3].word16());
+        out[i].offset= double(q[4].word16());
+        out[i].scale = double(q[5].word16());
+        out[i].max_output = double(q[6].word16());
+        out[i].stiction_up_val = double(q[7].word16(0));
+        out[i].stiction_down_val = double(q[7].word16(1));
     }
 
-    return true;
+    return ret;
 }
 
 bool CanBusMotionControl::setTorquePidsRaw(const Pid *pids)
@@ -4797,13 +4816,45 @@ bool CanBusMotionControl::getTorquePidsRaw (Pid *out)
 {
     CanBusResources& r = RES(system_resources);
 
-    int i;
-    for (i = 0; i < r.getJoints(); i++)
+    // the same messages of getTorquePidRaw(), for all the joints in a single batch
+    const int msgs[] = { ICUBCANPROTO_POL_MC_CMD__GET_TORQUE_PID, ICUBCANPROTO_POL_MC_CMD__GET_TORQUE_PIDLIMITS,
+                         ICUBCANPROTO_POL_MC_CMD__GET_MODEL_PARAMS, ICUBCANPROTO_POL_MC_CMD__GET_TORQUE_STICTION_PARAMS };
+    const int nmsgs = sizeof(msgs)/sizeof(msgs[0]);
+    const int nj = r.getJoints();
+
+    std::vector<CanReadRequest> requests(nj*nmsgs);
+    for (int i = 0; i < nj; i++)
     {
-        getTorquePidRaw(i, &(out[i]));
+        for (int k = 0; k < nmsgs; k++)
+        {
+            requests[i*nmsgs+k].msg = msgs[k];
+            requests[i*nmsgs+k].axis = i;
+        }
     }
 
-    return true;
+    if (nj < 1)
+        return true;
+
+    bool ret = _readBatch(&requests[0], nj*nmsgs);
+
+    for (int i = 0; i < nj; i++)
+    {
+        const CanReadRequest *q = &requests[i*nmsgs];
+        if (!ENABLED(i))
+            continue;
+        out[i].kp = q[0].word16(0);
+        out[i].ki = q[0].word16(1);
+        out[i].kd = q[0].word16(2);
+        out[i].scale = *((char *)(q[0].data+6));
+        out[i].offset = q[1].word16(0);
+        out[i].max_output = q[1].word16(1);
+        out[i].max_int = q[1].word16(2);
+        out[i].kff = q[2].word16(0);
+        out[i].stiction_up_val = double(q[3].word16(0));
+        out[i].stiction_down_val = double(q[3].word16(1));
+    }
+
+    return ret;
 }
 
 bool CanBusMotionControl::setPidsRaw(const Pid *pids)
@@ -5817,22 +5868,27 @@ bool CanBusMotionControl::getRefSpeedRaw (int axis, double *spd)
     return true;
 }
 
-/// cmd is an array of double (LATER: to be optimized).
+/// cmd is an array of double. all the joints are asked in a single batch.
 bool CanBusMotionControl::getRefAccelerationsRaw (double *accs)
 {
     CanBusResources& r = RES(system_resources);
-    int i;
-    short value = 0;
+    const int nj = r.getJoints();
 
-    for(i = 0; i < r.getJoints(); i++)
+    std::vector<CanReadRequest> requests(nj);
+    for (int i = 0; i < nj; i++)
     {
-        if (_readWord16 (ICUBCANPROTO_POL_MC_CMD__GET_DESIRED_ACCELER, i, value) == true) {
-            _ref_accs[i] = accs[i] = double (value);
-            accs[i] *= 1000.0;
-            accs[i] *= 1000.0;
-        }
-        else
-            return false;
+        requests[i].msg = ICUBCANPROTO_POL_MC_CMD__GET_DESIRED_ACCELER;
+        requests[i].axis = i;
+    }
+
+    if (nj < 1 || !_readBatch(&requests[0], nj))
+        return false;
+
+    for (int i = 0; i < nj; i++)
+    {
+        _ref_accs[i] = accs[i] = double (requests[i].word16());
+        accs[i] *= 1000.0;
+        accs[i] *= 1000.0;
     }
 
     return true;
@@ -6699,15 +6755,18 @@ bool CanBusMotionControl::getLimitsRaw(int axis, double *min, double *max)
 {
     if (!(axis >= 0 && axis <= (CAN_MAX_CARDS-1)*2))
         return false;
-    int iMin=0;
-    int iMax=0;
-    bool ret=true;
 
-    ret = ret && _readDWord (ICUBCANPROTO_POL_MC_CMD__GET_MIN_POSITION, axis, iMin);
-    ret = ret && _readDWord (ICUBCANPROTO_POL_MC_CMD__GET_MAX_POSITION, axis, iMax);
+    // both limits are asked in the same round trip
+    CanReadRequest requests[2];
+    requests[0].msg = ICUBCANPROTO_POL_MC_CMD__GET_MIN_POSITION;
+    requests[0].axis = axis;
+    requests[1].msg = ICUBCANPROTO_POL_MC_CMD__GET_MAX_POSITION;
+    requests[1].axis = axis;
+
+    bool ret = _readBatch(requests, 2);
 
-    *min=iMin;
-    *max=iMax;
+    *min=requests[0].dword();
+    *max=requests[1].dword();
 
     return ret;
 }
@@ -7289,6 +7348,101 @@ bool CanBusMotionControl::_readDWordArray (int msg, double *out)
     return true;
 }
 
+/// reads many (msg, axis) pairs at once. all the requests go in a single
+/// writePacket(), _mutex is released while the replies are gathered by the
+/// thread table and they all share the same timeout, so that the periodic
+/// thread is never starved and the caller pays one round trip only.
+bool CanBusMotionControl::_readBatch (CanReadRequest *requests, int n)
+{
+    CanBusResources& r = RES(system_resources);
+    bool ret = true;
+
+    for (int k = 0; k < n; k++)
+    {
+        requests[k].replied = false;
+        memset(requests[k].data, 0, sizeof(requests[k].data));
+    }
+
+    int first = 0;
+    while (first < n)
+    {
+        _mutex.wait();
+        int id;
+        if (!threadPool->getId(id))
+        {
+            yError("More than %d threads, cannot allow more\n", CANCONTROL_MAX_THREADS);
+            _mutex.post();
+            return false;
+        }
+
+        r.startPacket();
+
+        // the write buffer and the thread table hold at most BUF_SIZE messages
+        int last = first;
+        for (; (last < n) && (r._writeMessages < BUF_SIZE); last++)
+        {
+            int axis = requests[last].axis;
+            if (!(axis >= 0 && axis <= (CAN_MAX_CARDS-1)*2))
+            {
+                ret = false;
+                continue;
+            }
+            if (ENABLED(axis))
+            {
+                r.addMessage (id, axis, requests[last].msg);
+            }
+            else
+            {
+                // disabled axes reply zero as in the single message functions
+                requests[last].replied = true;
+            }
+        }
+
+        if (r._writeMessages < 1)
+        {
+            _mutex.post();
+            first = last;
+            continue;
+        }
+
+        r.writePacket();
+
+        ThreadTable2 *t=threadPool->getThreadTable(id);
+        t->setPending(r._writeMessages);
+        _mutex.post();
+        t->synch();
+
+        if (!r.getErrorStatus() || t->timedOut())
+        {
+            yError("readBatch: at least one message timed out\n");
+            ret = false;
+        }
+
+        for (int k = first; k < last; k++)
+        {
+            int axis = requests[k].axis;
+            if (!(axis >= 0 && axis <= (CAN_MAX_CARDS-1)*2) || !ENABLED(axis))
+                continue;
+
+            CanMessage *m = t->getByJointAndMsg(axis, requests[k].msg, r._destInv);
+            if ( (m!=0) && (m->getId() != 0xffff) )
+            {
+                memcpy(requests[k].data, m->getData()+1, sizeof(requests[k].data));
+                requests[k].replied = true;
+            }
+            else
+            {
+                ret = false;
+            }
+        }
+
+        t->clear();
+        first = last;
+    }
+
+    return ret;
+}
+
 bool CanBusMotionControl::_readWord16 (int msg, int axis, short& value)
 {
     CanBusResources& r = RES(system_resources);
@@ -40,6 +40,8 @@
 #include <yarp/os/RateThread.h>
 #include <string>
 #include <list>
+#include <vector>
+#include <string.h>
 
 #include <iCub/FactoryInterface.h>
 #include <iCub/LoggerInterfaces.h>
@@ -54,6 +56,31 @@ namespace yarp{
 
 class ThreadPool2;
 class RequestsQueue;
+
+/**
+* A single request of a batched read: the polling message msg is sent to axis
+* and the payload of the reply (the bytes following the message type) is
+* copied into data. replied tells whether the reply has arrived in time.
+*/
+struct CanReadRequest
+{
+    int msg;
+    int axis;
+    unsigned char data[7];
+    bool replied;
+
+    CanReadRequest()
+    {
+        msg=0;
+        axis=0;
+        memset(data, 0, sizeof(data));
+        replied=false;
+    }
+
+    inline short word16(int i=0) const { return *((short *)(data+2*i)); }
+    inline int   dword() const { return *((int *)(data)); }
+};
+
 struct SpeedEstimationParameters
 {
     double jnt_Vel_estimator_shift;
@@ -1158,6 +1185,7 @@ protected:
     bool _readWord16Array (int msg, double *out);
     bool _readDWord (int msg, int axis, int& value);
     bool _readDWordArray (int msg, double *out);
+    bool _readBatch (CanReadRequest *requests, int n);
     bool _writeDWord (int msg, int axis, int value);
     bool _writeNone  (int msg, int axis);
     bool _writeByte8 (int msg, int axis, int value);
@@ -98,6 +98,10 @@ public:
     //get can message from joint number
     inline yarp::dev::CanMessage *getByJoint(int j, const unsigned char *destInv);
 
+    //get can message from joint number and message type, used when many
+    //different messages have been requested to the same joint
+    inline yarp::dev::CanMessage *getByJointAndMsg(int j, int msg, const unsigned char *destInv);
+
     //get n-nth message in the list of replies
     inline yarp::dev::CanMessage *get(int n);
 };
@@ -118,6 +122,14 @@ yarp::dev::CanMessage *ThreadTable2::getByJoint(int j, const unsigned char *dest
     return 0;
 }
 
+yarp::dev::CanMessage *ThreadTable2::getByJointAndMsg(int j, int msg, const unsigned char *destInv)
+{
+    for(int k=0;k<_replied;k++)
+        if ((getJoint(_replies[k], destInv)==j) && ((_replies[k].getData()[0] & 0x7F)==msg))
+            return &_replies[k];
+    return 0;
+}
+
 bool ThreadTable2::push(const yarp::dev::CanMessage &m)
 {
     lock();
@@ -11,6 +11,7 @@
 #include <ethManager.h>
 #include <ethResource.h>
 #include <errno.h>
+#include <time.h>
 
 #include "EOYtheSystem.h"
 
@@ -487,6 +488,13 @@ TheEthManager::TheEthManager()
 
     // the time of creation according to yarp
     startUpTime = yarp::os::Time::now();
+
+    // the storage used by Transmission()
+    txPackets = new ethTXpacket_t[maxBoards];
+    numofTXpackets = 0;
+
+    ConstString tmp = NetworkBase::getEnvironment("ETHSTAT_PRINT_INTERVAL");
+    collectTXstatistics = ((tmp != "") && (NetType::toInt(tmp) > 0)) ? true : false;
 }
 
 
@@ -532,6 +540,9 @@ TheEthManager::~TheEthManager()
     ethBoards->execute(delete_resources, NULL);
     delete ethBoards;
 
+    delete[] txPackets;
+    txPackets = NULL;
+
     lock(false);
 
     handle = NULL;
@@ -612,7 +623,7 @@ void TheEthManager::initEOYsystem(void)
 
 
 
-void ethEvalTXropframe(EthResource *r, void* p)
+void ethCollectTXropframe(EthResource *r, void* p)
 {
     if((NULL == r) || (NULL == p))
     {
@@ -620,31 +631,93 @@ void ethEvalTXropframe(EthResource *r, void* p)
     }
 
     TheEthManager *ethman = (TheEthManager*)p;
+    ethman->collectTXpacket(r);
+}
+
+
+void TheEthManager::collectTXpacket(EthResource* r)
+{
+    // the asynchronous queries of the board are checked at every transmission cycle, even if its packet is not sent
+    r->expireNetQueries(yarp::os::Time::now());
+
+    if(numofTXpackets >= maxBoards)
+    {
+        return;
+    }
 
     uint16_t numofbytes = 0;
     uint16_t numofrops = 0;
     uint8_t* data2send = NULL;
     bool transmitthepacket = r->getTXpacket(&data2send, &numofbytes, &numofrops);
 
-    if(true == transmitthepacket)
+    if((true == transmitthepacket) && (numofbytes <= EthResource::maxTXpacketsize))
     {
-        ACE_INET_Addr ipaddress = r->getRemoteAddress();
-        ethman->sendPacket(data2send, (size_t)numofbytes, ipaddress);
+        // we copy the ropframe because the EthResource may be released as soon as we release the tx lock
+        ethTXpacket_t &pkt = txPackets[numofTXpackets];
+        memcpy(pkt.data, data2send, numofbytes);
+        pkt.size = numofbytes;
+        pkt.address = r->getRemoteAddress();
+        numofTXpackets++;
     }
 }
 
 
 bool TheEthManager::Transmission(void)
 {
+    double timeofstart = 0;
+    double timeofunlock = 0;
+
+    if(collectTXstatistics)
+    {
+        timeofstart = yarp::os::Time::now();
+    }
+
+    // we hold the tx lock only while we copy the ropframes of the EthResource. the socket i/o is done after the lock is released
     lockTX(true);
 
-    ethBoards->execute(ethEvalTXropframe, this);
+    numofTXpackets = 0;
+    ethBoards->execute(ethCollectTXropframe, this);
 
     lockTX(false);
 
+    if(collectTXstatistics)
+    {
+        timeofunlock = yarp::os::Time::now();
+    }
+
+    int numofpackets = numofTXpackets;
+    if(numofpackets > 0)
+    {
+        sendPackets(txPackets, numofpackets);
+    }
+
+    if(collectTXstatistics)
+    {
+        double timeofend = yarp::os::Time::now();
+        txStatMutex.wait();
+        txStats.cycletime.add(timeofend - timeofstart);
+        txStats.locktime.add(timeofunlock - timeofstart);
+        txStats.packetspercycle.add(numofpackets);
+        txStatMutex.post();
+    }
+
     return true;
 }
 
+
+void TheEthManager::getTXstatistics(txStatistics_t &stats, bool reset)
+{
+    txStatMutex.wait();
+    stats = txStats;
+    if(reset)
+    {
+        txStats.cycletime.clear();
+        txStats.locktime.clear();
+        txStats.packetspercycle.clear();
+    }
+    txStatMutex.post();
+}
+
 bool TheEthManager::verifyEthBoardInfo(yarp::os::Searchable &cfgtotal, eOipv4addr_t* boardipv4, char *boardipv4string, int stringsize)
 {
     // Get PC104 address and port from config file
@@ -1182,7 +1255,116 @@ int TheEthManager::sendPacket(void *udpframe, size_t len, ACE_INET_Addr toaddres
 }
 
 
+int TheEthManager::sendPackets(ethTXpacket_t* packets, int numofpackets)
+{
+    if((NULL == packets) || (numofpackets <= 0))
+    {
+        return 0;
+    }
+
+    int sent = 0;
+
+#if defined(__linux__)
+    ACE_HANDLE sockfd = UDP_socket->get_handle();
+
+    // a failure affects only the packet at the head of the batch: every board is still sent its own packet
+    const int maxRetries = 3;
+    int retries = 0;
+    int done = 0;   // packets either sent or dropped
+    while(done < numofpackets)
+    {
+        int num = numofpackets - done;
+        if(num > maxBoards)
+        {
+            num = maxBoards;
+        }
+
+        for(int i=0; i<num; i++)
+        {
+            ethTXpacket_t &pkt = packets[done+i];
+            txIovecs[i].iov_base = pkt.data;
+            txIovecs[i].iov_len = pkt.size;
+            txMsgs[i].msg_hdr.msg_name = pkt.address.get_addr();
+            txMsgs[i].msg_hdr.msg_namelen = pkt.address.get_size();
+            txMsgs[i].msg_hdr.msg_iov = &txIovecs[i];
+            txMsgs[i].msg_hdr.msg_iovlen = 1;
+            txMsgs[i].msg_hdr.msg_control = NULL;
+            txMsgs[i].msg_hdr.msg_controllen = 0;
+            txMsgs[i].msg_hdr.msg_flags = 0;
+            txMsgs[i].msg_len = 0;
+        }
+
+        int ret = ::sendmmsg(sockfd, txMsgs, num, 0);
+        if(ret > 0)
+        {
+            sent += ret;
+            done += ret;
+            retries = 0;
+            continue;
+        }
+
+        int err = errno;
+        if(((EINTR == err) || (EAGAIN == err) || (EWOULDBLOCK == err)) && (retries < maxRetries))
+        {
+            // transient condition: try again the same packet
+            retries++;
+            continue;
+        }
+
+        // drop only the packet that failed and go on with the other boards
+        yError() << "TheEthManager::sendPackets() drops the packet to" << packets[done].address.get_host_addr() << "after sendmmsg() failure: errno =" << err;
+        done++;
+        retries = 0;
+    }
+#else
+    for(int i=0; i<numofpackets; i++)
+    {
+        if(sendPacket(packets[i].data, packets[i].size, packets[i].address) > 0)
+        {
+            sent++;
+        }
+    }
+#endif
+
+    return sent;
+}
+
+
 bool TheEthManager::Reception(ACE_INET_Addr adr, uint64_t* data, ssize_t size, bool collectStatistics)
+{
+    lockRX(true);
+
+    processRXpacket(adr, data, size, collectStatistics);
+
+    lockRX(false);
+
+
+    return(true);
+}
+
+
+bool TheEthManager::Reception(ethRXpacket_t* packets, int numofpackets, bool collectStatistics)
+{
+    if((NULL == packets) || (numofpackets <= 0))
+    {
+        return false;
+    }
+
+    lockRX(true);
+
+    for(int i=0; i<numofpackets; i++)
+    {
+        processRXpacket(packets[i].address, packets[i].data, packets[i].size, collectStatistics);
+    }
+
+    lockRX(false);
+
+
+    return(true);
+}
+
+
+void TheEthManager::processRXpacket(ACE_INET_Addr &adr, uint64_t* data, ssize_t size, bool collectStatistics)
 {
     ACE_UINT32 a32 = adr.get_ip_address();
     uint8_t ip4 = a32 & 0xff;
@@ -1192,8 +1374,6 @@ bool TheEthManager::Reception(ACE_INET_Addr adr, uint64_t* data, ssize_t size, b
 
     eOipv4addr_t ipv4addr = eo_common_ipv4addr(ip1, ip2, ip3, ip4);
 
-    lockRX(true);
-
     EthResource* r = ethBoards->get_resource(ipv4addr);
 
     if(NULL != r)
@@ -1213,11 +1393,6 @@ bool TheEthManager::Reception(ACE_INET_Addr adr, uint64_t* data, ssize_t size, b
     //    adr.addr_to_string(address, sizeof(address));
     //    yError() << "TheEthManager::Reception cannot get a ethres associated to address" << address;
     }
-
-    lockRX(false);
-
-
-    return(true);
 }
 
 
@@ -1330,6 +1505,17 @@ EthSender::EthSender(int txrate) : RateThread(txrate)
     rateofthread = txrate;
     yDebug() << "EthSender is a RateThread with txrate =" << rateofthread << "ms";
     yTrace();
+
+    ConstString tmp = NetworkBase::getEnvironment("ETHSTAT_PRINT_INTERVAL");
+    if (tmp != "")
+    {
+        statPrintInterval = (double)NetType::toInt(tmp);
+    }
+    else
+    {
+        statPrintInterval = 0.0;
+    }
+    timeoflastprint = yarp::os::Time::now();
 }
 
 EthSender::~EthSender()
@@ -1372,6 +1558,32 @@ void EthSender::run()
     // for tx we must protect the EthResource not being changed. they can be changed by a device such as
     // embObjMotionControl etc which adds or releases its resources.
     ethManager->Transmission();
+
+    if(statPrintInterval > 0)
+    {
+        double now = yarp::os::Time::now();
+        if((now - timeoflastprint) >= statPrintInterval)
+        {
+            printStatistics();
+            timeoflastprint = now;
+        }
+    }
+}
+
+
+void EthSender::printStatistics()
+{
+    TheEthManager::txStatistics_t stats;
+    ethManager->getTXstatistics(stats, true);
+
+    if(0 == stats.cycletime.count())
+    {
+        return;
+    }
+
+    yDebug() << "  (STATS-TX)-> EthSender duration of tx cycle: avg=" << stats.cycletime.mean()*1000000 << "us std=" << stats.cycletime.deviation()*1000000 << "us min=" << stats.cycletime.getMin()*1000000 << "us max=" << stats.cycletime.getMax()*1000000 << "us on" << stats.cycletime.count() << "values";
+    yDebug() << "  (STATS-TX)-> EthSender time tx lock is held: avg=" << stats.locktime.mean()*1000000 << "us std=" << stats.locktime.deviation()*1000000 << "us min=" << stats.locktime.getMin()*1000000 << "us max=" << stats.locktime.getMax()*1000000 << "us on" << stats.locktime.count() << "values";
+    yDebug() << "  (STATS-TX)-> EthSender packets per tx cycle: avg=" << stats.packetspercycle.mean() << "std=" << stats.packetspercycle.deviation() << "min=" << stats.packetspercycle.getMin() << "max=" << stats.packetspercycle.getMax() << "on" << stats.packetspercycle.count() << "values\n";
 }
 
 
@@ -1392,6 +1604,29 @@ EthReceiver::EthReceiver(int raterx): RateThread(raterx)
     {
         statPrintInterval = 0.0;
     }
+
+    rxmode = rxmode_polling;
+    ConstString _rxmode = NetworkBase::getEnvironment("ETHRECEIVER_MODE");
+    if(_rxmode == "batch")
+    {
+#if defined(__linux__)
+        rxmode = rxmode_batch;
+#else
+        yWarning() << "EthReceiver: ETHRECEIVER_MODE=batch is supported only on linux. thus using mode polling";
+#endif
+    }
+
+#if defined(__linux__)
+    batchdata = NULL;
+    if(rxmode_batch == rxmode)
+    {
+        batchdata = new uint64_t[maxRXbatchsize][EthResource::maxRXpacketsize/8];
+    }
+#endif
+
+    batchStats.wakeups = 0;
+    batchStats.packets = 0;
+    timeoflastprint = yarp::os::Time::now();
 }
 
 void EthReceiver::onStop()
@@ -1403,7 +1638,13 @@ void EthReceiver::onStop()
 
 EthReceiver::~EthReceiver()
 {
-
+#if defined(__linux__)
+    if(NULL != batchdata)
+    {
+        delete[] batchdata;
+        batchdata = NULL;
+    }
+#endif
 }
 
 bool EthReceiver::config(ACE_SOCK_Dgram *pSocket, TheEthManager* _ethManager)
@@ -1440,7 +1681,45 @@ bool EthReceiver::config(ACE_SOCK_Dgram *pSocket, TheEthManager* _ethManager)
 
     yWarning() << "in EthReceiver::config() the config socket has queue size = "<< sock_input_buf_size<< "; you request ETHRECEIVER_BUFFER_SIZE=" << _dgram_buffer_size;
 
+    if(rxmode_batch == rxmode)
+    {
+        if(false == configBatch())
+        {
+            yWarning() << "EthReceiver::config() cannot configure mode batch. thus using mode polling";
+            rxmode = rxmode_polling;
+        }
+    }
+
+    yDebug() << "EthReceiver::config() uses mode" << ((rxmode_batch == rxmode) ? "batch" : "polling");
+
+    return true;
+}
+
+
+bool EthReceiver::configBatch()
+{
+#if defined(__linux__)
+    ACE_HANDLE sockfd = recv_socket->get_handle();
+
+    // we ask the kernel to timestamp the packets, so that we can measure how long they stay in the queue
+    int enable = 1;
+    if(0 != ACE_OS::setsockopt(sockfd, SOL_SOCKET, SO_TIMESTAMPNS, (char *)&enable, sizeof(enable)))
+    {
+        yWarning() << "EthReceiver::configBatch() cannot set SO_TIMESTAMPNS: the queue time will not be measured";
+    }
+
+    for(int i=0; i<maxRXbatchsize; i++)
+    {
+        batchiovecs[i].iov_base = batchdata[i];
+        batchiovecs[i].iov_len = EthResource::maxRXpacketsize;
+        batchpackets[i].data = batchdata[i];
+        batchpackets[i].size = 0;
+    }
+
     return true;
+#else
+    return false;
+#endif
 }
 
 
@@ -1471,6 +1750,19 @@ uint64_t getRopFrameAge(char *pck)
 
 
 void EthReceiver::run()
+{
+    if(rxmode_batch == rxmode)
+    {
+        runBatch();
+    }
+    else
+    {
+        runPolling();
+    }
+}
+
+
+void EthReceiver::runPolling()
 {
     ssize_t       incoming_msg_size = 0;
     ACE_INET_Addr sender_addr;
@@ -1507,6 +1799,166 @@ void EthReceiver::run()
 }
 
 
+void EthReceiver::runBatch()
+{
+#if defined(__linux__)
+    ACE_HANDLE sockfd = recv_socket->get_handle();
+
+    // we block until something arrives. the timeout of a few periods lets the thread check isStopping() and print statistics.
+    // onStop() sends a small packet to ourselves to unblock us quickly.
+    struct pollfd pfd;
+    pfd.fd = sockfd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int r = ::poll(&pfd, 1, 10*rateofthread);
+
+    if(isStopping())
+    {
+        return;
+    }
+
+    bool collectStatistics = (statPrintInterval > 0) ? true : false;
+
+    if((r > 0) && (0 != (pfd.revents & POLLIN)))
+    {
+        int packetsinwakeup = 0;
+
+        // we drain the queue: we stop when recvmmsg() returns less packets than requested
+        for(;;)
+        {
+            for(int i=0; i<maxRXbatchsize; i++)
+            {
+                batchmsgs[i].msg_hdr.msg_name = &batchaddrs[i];
+                batchmsgs[i].msg_hdr.msg_namelen = sizeof(batchaddrs[i]);
+                batchmsgs[i].msg_hdr.msg_iov = &batchiovecs[i];
+                batchmsgs[i].msg_hdr.msg_iovlen = 1;
+                batchmsgs[i].msg_hdr.msg_control = batchcontrol[i];
+                batchmsgs[i].msg_hdr.msg_controllen = sizeof(batchcontrol[i]);
+                batchmsgs[i].msg_hdr.msg_flags = 0;
+                batchmsgs[i].msg_len = 0;
+            }
+
+            int n = ::recvmmsg(sockfd, batchmsgs, maxRXbatchsize, MSG_DONTWAIT, NULL);
+            if(n <= 0)
+            {
+                break;
+            }
+
+            struct timespec now;
+            clock_gettime(CLOCK_REALTIME, &now);
+
+            int numofpackets = 0;
+            for(int i=0; i<n; i++)
+            {
+                if(0 == batchmsgs[i].msg_len)
+                {
+                    continue;
+                }
+
+                if(collectStatistics)
+                {
+                    for(struct cmsghdr *cmsg = CMSG_FIRSTHDR(&batchmsgs[i].msg_hdr); NULL != cmsg; cmsg = CMSG_NXTHDR(&batchmsgs[i].msg_hdr, cmsg))
+                    {
+                        if((SOL_SOCKET == cmsg->cmsg_level) && (SO_TIMESTAMPNS == cmsg->cmsg_type))
+                        {
+                            struct timespec *ts = (struct timespec *) CMSG_DATA(cmsg);
+                            double queuetime = (double)(now.tv_sec - ts->tv_sec) + 1.0e-9*(double)(now.tv_nsec - ts->tv_nsec);
+                            statMutex.wait();
+                            batchStats.queuetime.add(queuetime);
+                            statMutex.post();
+                        }
+                    }
+                }
+
+                // we keep only the valid packets, thus we compact the array of packets given to the ethmanager
+                batchpackets[numofpackets].address.set(&batchaddrs[i], sizeof(batchaddrs[i]));
+                batchpackets[numofpackets].data = batchdata[i];
+                batchpackets[numofpackets].size = batchmsgs[i].msg_len;
+                numofpackets++;
+            }
+
+            if(numofpackets > 0)
+            {
+                ethManager->Reception(batchpackets, numofpackets, collectStatistics);
+            }
+
+            packetsinwakeup += n;
+
+            statMutex.wait();
+            batchStats.batchsize.add(n);
+            statMutex.post();
+
+            if(n < maxRXbatchsize)
+            {
+                break;
+            }
+        }
+
+        statMutex.wait();
+        batchStats.packetsperwakeup.add(packetsinwakeup);
+        batchStats.wakeups++;
+        batchStats.packets += packetsinwakeup;
+        statMutex.post();
+    }
+
+    if(collectStatistics)
+    {
+        double now = yarp::os::Time::now();
+        if((now - timeoflastprint) >= statPrintInterval)
+        {
+            printBatchStatistics();
+            timeoflastprint = now;
+        }
+    }
+#else
+    runPolling();
+#endif
+}
+
+
+EthReceiver::rxMode_t EthReceiver::getMode(void)
+{
+    return rxmode;
+}
+
+
+void EthReceiver::getBatchStatistics(rxBatchStatistics_t &stats, bool reset)
+{
+    statMutex.wait();
+    stats = batchStats;
+    if(reset)
+    {
+        batchStats.batchsize.clear();
+        batchStats.packetsperwakeup.clear();
+        batchStats.queuetime.clear();
+        batchStats.wakeups = 0;
+        batchStats.packets = 0;
+    }
+    statMutex.post();
+}
+
+
+void EthReceiver::printBatchStatistics()
+{
+    rxBatchStatistics_t stats;
+    getBatchStatistics(stats, true);
+
+    yDebug() << "  (STATS-RX)-> EthReceiver in mode batch:" << stats.packets << "packets in" << stats.wakeups << "wakeups in this period";
+
+    if(0 != stats.wakeups)
+    {
+        yDebug() << "  (STATS-RX)-> EthReceiver packets per recvmmsg(): avg=" << stats.batchsize.mean() << "std=" << stats.batchsize.deviation() << "min=" << stats.batchsize.getMin() << "max=" << stats.batchsize.getMax() << "on" << stats.batchsize.count() << "values";
+        yDebug() << "  (STATS-RX)-> EthReceiver packets per wakeup: avg=" << stats.packetsperwakeup.mean() << "std=" << stats.packetsperwakeup.deviation() << "min=" << stats.packetsperwakeup.getMin() << "max=" << stats.packetsperwakeup.getMax() << "on" << stats.packetsperwakeup.count() << "values";
+    }
+
+    if(0 != stats.queuetime.count())
+    {
+        yDebug() << "  (STATS-RX)-> EthReceiver time in socket queue: avg=" << stats.queuetime.mean()*1000 << "ms std=" << stats.queuetime.deviation()*1000 << "ms min=" << stats.queuetime.getMin()*1000 << "ms max=" << stats.queuetime.getMax()*1000 << "ms on" << stats.queuetime.count() << "values\n";
+    }
+}
+
+
 
 // eof
 
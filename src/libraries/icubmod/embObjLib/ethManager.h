@@ -38,6 +38,12 @@
 #include <stdio.h>
 #include <map>
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <poll.h>
+#endif
+
 
 // ACE includes
 #include <ace/ACE.h>
@@ -89,6 +95,24 @@ typedef struct
     iethresType_t type;
 } interfaceInfo_t;
 
+// -- it describes a single udp packet received from the socket. it is used by EthReceiver to pass
+// -- to TheEthManager::Reception() all the packets it has drained from the socket in one go.
+typedef struct
+{
+    ACE_INET_Addr   address;
+    uint64_t*       data;
+    ssize_t         size;
+} ethRXpacket_t;
+
+// -- it describes a single udp packet to be transmitted. TheEthManager::Transmission() copies the ropframes of all the
+// -- EthResource into an array of them while holding the tx lock and sends them after the lock has been released.
+typedef struct
+{
+    ACE_INET_Addr   address;
+    uint16_t        size;
+    uint8_t         data[EthResource::maxTXpacketsize];
+} ethTXpacket_t;
+
 class EthBoards
 {
 
@@ -217,6 +241,9 @@ public:
 
     bool Reception(ACE_INET_Addr adr, uint64_t* data, ssize_t size, bool collectStatistics);
 
+    // it processes a batch of packets holding the rx lock only once.
+    bool Reception(ethRXpacket_t* packets, int numofpackets, bool collectStatistics);
+
     EthResource* getEthResource(eOipv4addr_t ipv4);
 
     IethResource* getInterface(eOipv4addr_t ipv4, eOprotID32_t id32);
@@ -227,6 +254,23 @@ public:
 
     int sendPacket(void *udpframe, size_t len, ACE_INET_Addr toaddress);
 
+    // it is used by Transmission() to copy the ropframe of a single EthResource into the pre-allocated tx packets.
+    void collectTXpacket(EthResource* r);
+
+    // it sends numofpackets packets. on linux it uses a single sendmmsg(). it returns the number of packets sent.
+    int sendPackets(ethTXpacket_t* packets, int numofpackets);
+
+    // statistics of the transmission. time is expressed in seconds.
+    typedef struct
+    {
+        StatExt         cycletime;          // duration of a Transmission()
+        StatExt         locktime;           // time the tx lock is held inside a Transmission()
+        StatExt         packetspercycle;    // number of packets sent by a Transmission()
+    } txStatistics_t;
+
+    // it copies the statistics of the transmission. if reset is true they are cleared after the copy.
+    void getTXstatistics(txStatistics_t &stats, bool reset = false);
+
 private:
 
     bool isCommunicationInitted(void);
@@ -243,6 +287,9 @@ private:
     bool lockRX(bool on);
     bool lockTXRX(bool on);
 
+    // it gives the packet to the relevant EthResource. it must be called with rx lock taken.
+    void processRXpacket(ACE_INET_Addr &adr, uint64_t* data, ssize_t size, bool collectStatistics);
+
 
 private:
 
@@ -269,6 +316,18 @@ private:
     EthReceiver* receiver;
     ACE_SOCK_Dgram* UDP_socket;
 
+    // pre-allocated storage used by Transmission(). it is used only by the EthSender thread.
+    ethTXpacket_t* txPackets;
+    int numofTXpackets;
+#if defined(__linux__)
+    struct mmsghdr txMsgs[maxBoards];
+    struct iovec txIovecs[maxBoards];
+#endif
+
+    bool collectTXstatistics;
+    yarp::os::Semaphore txStatMutex;
+    txStatistics_t txStats;
+
 };
 
 
@@ -280,6 +339,8 @@ class EthSender : public yarp::os::RateThread
 {
 private:
     int rateofthread;
+    double statPrintInterval;
+    double timeoflastprint;
 
     uint8_t                       *p_sendData;
     TheEthManager                 *ethManager;
@@ -296,15 +357,46 @@ public:
     bool config(ACE_SOCK_Dgram *pSocket, TheEthManager* _ethManager);
     bool threadInit();
 
+private:
+    void printStatistics();
+
 };
 
 
 // -- class EthReceiver
 // -- it is a rate thread created by singleton TheEthManager.
-// -- it regularly wakes up to see if a packet is in its listening socket and it parses that with methods made available by TheEthManager.
+// -- in mode polling (the default) it regularly wakes up to see if a packet is in its listening socket and it parses that
+// -- with methods made available by TheEthManager.
+// -- in mode batch (linux only, selected with environment variable ETHRECEIVER_MODE=batch) it blocks on the socket until
+// -- something arrives, then it drains all the queued packets with recvmmsg() and gives them to TheEthManager in one call.
+// -- in mode batch it also keeps statistics about the number of packets per recvmmsg(), the number of packets per wakeup
+// -- and the time the packets have spent in the kernel queue. they are printed every ETHSTAT_PRINT_INTERVAL seconds.
 
 class EthReceiver : public yarp::os::RateThread
 {
+public:
+
+    enum { EthReceiverDefaultRate = 5, EthReceiverMaxRate = 20 };
+
+    // max number of packets retrieved by a single recvmmsg()
+    enum { maxRXbatchsize = 64 };
+
+    typedef enum
+    {
+        rxmode_polling  = 0,
+        rxmode_batch    = 1
+    } rxMode_t;
+
+    // statistics of mode batch. time is expressed in seconds.
+    typedef struct
+    {
+        StatExt         batchsize;          // packets retrieved by a single recvmmsg()
+        StatExt         packetsperwakeup;   // packets retrieved after a single wake up of the thread
+        StatExt         queuetime;          // time between the arrival of the packet in the kernel and its retrieval
+        uint64_t        wakeups;
+        uint64_t        packets;
+    } rxBatchStatistics_t;
+
 private:
     int rateofthread;
 
@@ -312,10 +404,28 @@ private:
     TheEthManager                   *ethManager;
     double                          statPrintInterval;
 
+    rxMode_t                        rxmode;
 
-public:
+#if defined(__linux__)
+    // pre-allocated storage used by mode batch
+    uint64_t                        (*batchdata)[EthResource::maxRXpacketsize/8];
+    struct mmsghdr                  batchmsgs[maxRXbatchsize];
+    struct iovec                    batchiovecs[maxRXbatchsize];
+    struct sockaddr_in              batchaddrs[maxRXbatchsize];
+    uint8_t                         batchcontrol[maxRXbatchsize][64];
+    ethRXpacket_t                   batchpackets[maxRXbatchsize];
+#endif
 
-    enum { EthReceiverDefaultRate = 5, EthReceiverMaxRate = 20 };
+    yarp::os::Semaphore             statMutex;
+    rxBatchStatistics_t             batchStats;
+    double                          timeoflastprint;
+
+    void runPolling();
+    void runBatch();
+    bool configBatch();
+    void printBatchStatistics();
+
+public:
 
     EthReceiver(int rxrate);
     ~EthReceiver();
@@ -323,6 +433,11 @@ public:
     bool threadInit();
     void run();
     void onStop();
+
+    rxMode_t getMode(void);
+
+    // it copies the statistics of mode batch. if reset is true they are cleared after the copy.
+    void getBatchStatistics(rxBatchStatistics_t &stats, bool reset = false);
 };
 
 
@@ -31,29 +31,118 @@ using namespace yarp::os::impl;
 
 EthNetworkQuery::EthNetworkQuery()
 {
-    id2wait     = eo_prot_ID32dummy;
-    netwait     = new Semaphore(0);
-    isbusy      = new Semaphore(1);
-    iswaiting   = new Semaphore(0);
+    for(int i=0; i<maxOutstandingQueries; i++)
+    {
+        table[i].inuse          = false;
+        table[i].id32           = eo_prot_ID32dummy;
+        table[i].signature      = 0;
+        table[i].netwait        = new Semaphore(0);
+        table[i].async          = false;
+        table[i].oncompletion   = NULL;
+        table[i].par            = NULL;
+        table[i].deadline       = 0.0;
+    }
+    numofasync      = 0;
+    lastSignature   = 0;
+    tableLock   = new Semaphore(1);
+    freeSlots   = new Semaphore(maxOutstandingQueries);
+    reserveLock = new Semaphore(1);
 }
 
 EthNetworkQuery::~EthNetworkQuery()
 {
-    delete netwait;
-    delete isbusy;
-    delete iswaiting;
+    for(int i=0; i<maxOutstandingQueries; i++)
+    {
+        delete table[i].netwait;
+    }
+    delete tableLock;
+    delete freeSlots;
+    delete reserveLock;
+}
+
+int EthNetworkQuery::reserve(eOprotID32_t id32, uint32_t signature)
+{
+    // it must be called after a free entry has been taken from freeSlots
+    int index = -1;
+    tableLock->wait();
+    for(int i=0; i<maxOutstandingQueries; i++)
+    {
+        if(false == table[i].inuse)
+        {
+            index = i;
+            break;
+        }
+    }
+    // freeSlots guarantees that index is valid
+    table[index].inuse = true;
+    table[index].id32 = id32;
+    table[index].signature = signature;
+    // make sure that the semaphore has zero value. i use check() because if value is already zero it does not harm.
+    while(table[index].netwait->check());
+    tableLock->post();
+
+    return index;
+}
+
+void EthNetworkQuery::release(int index)
+{
+    // it must be called with tableLock taken
+    if(table[index].async)
+    {
+        numofasync--;
+    }
+    table[index].inuse = false;
+    table[index].id32 = eo_prot_ID32dummy;
+    table[index].async = false;
+    table[index].oncompletion = NULL;
+    table[index].par = NULL;
+    freeSlots->post();
+}
+
+bool EthNetworkQuery::matches(int index, eOprotID32_t id32, uint32_t signature)
+{
+    if((false == table[index].inuse) || (table[index].id32 != id32))
+    {
+        return false;
+    }
+    return((0 == table[index].signature) || (table[index].signature == signature));
 }
 
 Semaphore* EthNetworkQuery::start(eOprotID32_t id32, uint32_t signature)
 {
-    // i wait until the busy semaphore is released ... in this way no other thread is able to manage the true semaphore
-    isbusy->wait();
-    // i also enable someone else (e.g., the network callback functions to retrieve networkQuerySem and increment it
-    iswaiting->post();
+    // i wait until there is a free entry in the table
+    reserveLock->wait();
+    freeSlots->wait();
+    reserveLock->post();
+
+    int index = reserve(id32, signature);
+    return(table[index].netwait);
+}
+
+bool EthNetworkQuery::start(const vector<eOprotID32_t> &id32s, uint32_t signature, vector<Semaphore*> &sems)
+{
+    const size_t n = id32s.size();
+    if(n > (size_t)maxOutstandingQueries)
+    {
+        return(false);
+    }
 
-    id2wait = id32;
+    // i take all the entries i need before anybody else can take one: the entries are given back
+    // by stop() without taking reserveLock, thus waiting in here cannot lead to a deadlock
+    reserveLock->wait();
+    for(size_t k=0; k<n; k++)
+    {
+        freeSlots->wait();
+    }
+    reserveLock->post();
 
-    return(netwait);
+    sems.resize(n);
+    for(size_t k=0; k<n; k++)
+    {
+        sems[k] = table[reserve(id32s[k], signature)].netwait;
+    }
+
+    return(true);
 }
 
 bool EthNetworkQuery::wait(Semaphore *sem, double timeout)
@@ -67,38 +156,203 @@ bool EthNetworkQuery::wait(Semaphore *sem, double timeout)
 
 bool EthNetworkQuery::arrived(eOprotID32_t id32, uint32_t signature)
 {
-    Semaphore* sem = NULL;
-    signature = signature;
+    bool released = false;
+    onCompletion_t completions[maxOutstandingQueries];
+    void* pars[maxOutstandingQueries];
+    uint32_t signatures[maxOutstandingQueries];
+    int numofcompletions = 0;
+
+    tableLock->wait();
+    for(int i=0; i<maxOutstandingQueries; i++)
+    {
+        if(true == matches(i, id32, signature))
+        {
+            if(table[i].async)
+            {   // the completion is called once the table is unlocked, so that it can start another query
+                completions[numofcompletions] = table[i].oncompletion;
+                pars[numofcompletions] = table[i].par;
+                signatures[numofcompletions] = table[i].signature;
+                numofcompletions++;
+                release(i);
+            }
+            else
+            {   // i give the semaphore to the thread which is really waiting that id32
+                table[i].netwait->post();
+            }
+            released = true;
+        }
+    }
+    tableLock->post();
 
-    if((true == iswaiting->check()) && (id2wait == id32))
-    {   // i give the semaphore to the function which will unblock only if someone is really waiting that id32
-        sem = netwait;
+    for(int k=0; k<numofcompletions; k++)
+    {
+        completions[k](id32, signatures[k], true, pars[k]);
     }
 
+    return(released);
+}
+
+bool EthNetworkQuery::stop(Semaphore *sem)
+{
     if(NULL == sem)
     {
         return(false);
     }
 
-    sem->post();
+    bool found = false;
+    tableLock->wait();
+    for(int i=0; i<maxOutstandingQueries; i++)
+    {
+        if((true == table[i].inuse) && (sem == table[i].netwait))
+        {
+            // make sure that the semaphore has zero value, as replies may have arrived after a timeout
+            while(table[i].netwait->check());
+            release(i);
+            found = true;
+            break;
+        }
+    }
+    tableLock->post();
 
-    return(true);
+    return(found);
 }
 
-bool EthNetworkQuery::stop(Semaphore *sem)
+uint32_t EthNetworkQuery::newSignature(void)
+{
+    uint32_t signature = 0;
+    bool used = true;
+
+    tableLock->wait();
+    while(true == used)
+    {
+        // the lower 24 bits are a counter which skips zero, thus the signature is never equal to signatureTag alone
+        lastSignature = (lastSignature + 1) & ~signatureMask;
+        if(0 == lastSignature)
+        {
+            lastSignature = 1;
+        }
+        signature = signatureTag | lastSignature;
+
+        used = false;
+        for(int i=0; i<maxOutstandingQueries; i++)
+        {
+            if((true == table[i].inuse) && (signature == table[i].signature))
+            {
+                used = true;
+                break;
+            }
+        }
+    }
+    tableLock->post();
+
+    return(signature);
+}
+
+bool EthNetworkQuery::startAsync(eOprotID32_t id32, uint32_t signature, onCompletion_t oncompletion, void* par, double timeout)
 {
-    sem = sem;
-    // make sure that the control semaphores have zero value. i use check() because if value is already zero it does not harm.
-    iswaiting->check();
-    netwait->check();
+    if(NULL == oncompletion)
+    {
+        return(false);
+    }
 
-    id2wait = eo_prot_ID32dummy;
+    // it is called by threads which must not block, thus i do not wait for a free entry. i also do not take reserveLock:
+    // if a start() of many entries is waiting, it gets the entry back when this query completes.
+    if(false == freeSlots->check())
+    {
+        return(false);
+    }
+
+    // the entry is filled in one go, so that a reply never finds it half asynchronous
+    tableLock->wait();
+    int index = -1;
+    for(int i=0; i<maxOutstandingQueries; i++)
+    {
+        if(false == table[i].inuse)
+        {
+            index = i;
+            break;
+        }
+    }
+    table[index].inuse = true;
+    table[index].id32 = id32;
+    table[index].signature = signature;
+    table[index].async = true;
+    table[index].oncompletion = oncompletion;
+    table[index].par = par;
+    table[index].deadline = yarp::os::Time::now() + timeout;
+    numofasync++;
+    tableLock->post();
 
-    // release the network query semaphore for another call
-    isbusy->post();
     return(true);
 }
 
+bool EthNetworkQuery::cancelAsync(eOprotID32_t id32, uint32_t signature)
+{
+    bool found = false;
+    tableLock->wait();
+    for(int i=0; i<maxOutstandingQueries; i++)
+    {
+        if((true == table[i].inuse) && (true == table[i].async) && (id32 == table[i].id32) && (signature == table[i].signature))
+        {
+            release(i);
+            found = true;
+            break;
+        }
+    }
+    tableLock->post();
+
+    return(found);
+}
+
+void EthNetworkQuery::expire(double now)
+{
+    onCompletion_t completions[maxOutstandingQueries];
+    void* pars[maxOutstandingQueries];
+    eOprotID32_t ids[maxOutstandingQueries];
+    uint32_t signatures[maxOutstandingQueries];
+    int numofcompletions = 0;
+
+    tableLock->wait();
+    if(0 == numofasync)
+    {
+        tableLock->post();
+        return;
+    }
+    for(int i=0; i<maxOutstandingQueries; i++)
+    {
+        if((true == table[i].inuse) && (true == table[i].async) && (now >= table[i].deadline))
+        {
+            completions[numofcompletions] = table[i].oncompletion;
+            pars[numofcompletions] = table[i].par;
+            ids[numofcompletions] = table[i].id32;
+            signatures[numofcompletions] = table[i].signature;
+            numofcompletions++;
+            release(i);
+        }
+    }
+    tableLock->post();
+
+    for(int k=0; k<numofcompletions; k++)
+    {
+        completions[k](ids[k], signatures[k], false, pars[k]);
+    }
+}
+
+int EthNetworkQuery::outstanding(void)
+{
+    int n = 0;
+    tableLock->wait();
+    for(int i=0; i<maxOutstandingQueries; i++)
+    {
+        if(table[i].inuse)
+        {
+            n++;
+        }
+    }
+    tableLock->post();
+    return(n);
+}
+
 
 
 // - class EthResource
@@ -694,6 +948,38 @@ bool EthResource::aNetQueryReplyHasArrived(eOprotID32_t id32, uint32_t signature
 }
 
 
+bool EthResource::askRemoteValueAsync(eOprotID32_t id32, EthNetworkQuery::onCompletion_t oncompletion, void* par, double timeout)
+{
+    uint32_t signature = ethQuery->newSignature();
+
+    if(false == ethQuery->startAsync(id32, signature, oncompletion, par, timeout))
+    {
+        char nvinfo[128];
+        eoprot_ID2information(id32, nvinfo, sizeof(nvinfo));
+        yError() << "EthResource::askRemoteValueAsync() cannot reserve a query for" << nvinfo << "for BOARD" << getName() << "with IP" << getIPv4string() << ": too many outstanding queries";
+        return false;
+    }
+
+    if(false == addGetMessageWithSignature(id32, signature))
+    {
+        // the ask<> is not going out, thus nobody shall call the completion
+        ethQuery->cancelAsync(id32, signature);
+        char nvinfo[128];
+        eoprot_ID2information(id32, nvinfo, sizeof(nvinfo));
+        yError() << "EthResource::askRemoteValueAsync() cannot transmit a request about" << nvinfo << "to BOARD" << getName() << "with IP" << getIPv4string();
+        return false;
+    }
+
+    return true;
+}
+
+
+void EthResource::expireNetQueries(double now)
+{
+    ethQuery->expire(now);
+}
+
+
 
 bool EthResource::verifyBoardTransceiver()
 {
@@ -711,7 +997,7 @@ bool EthResource::verifyBoardTransceiver()
 
     // step 1: we ask the remote board the eoprot_tag_mn_comm_status variable and then we verify vs transceiver properties and .. mn protocol version
 
-    uint32_t signature = 0xaa000000;
+    uint32_t signature = ethQuery->newSignature();
     const eoprot_version_t * pc104versionMN = eoprot_version_of_endpoint_get(eoprot_endpoint_management);
     const double timeout = 0.100;   // now the timeout can be reduced because the board is already connected.
 
@@ -1045,7 +1331,7 @@ bool EthResource::verifyBoardPresence(void)
     const double timeout = 0.500;   // 500 ms is more than enough if board is present. if link is not on it is a good time to wait
     const int retries = 20;         // the number of retries depends on the above timeout and on link-up time of the EMS.
 
-    uint32_t signature = 0xaa000000;
+    uint32_t signature = ethQuery->newSignature();
     eOprotID32_t id2send = eoprot_ID_get(eoprot_endpoint_management, eoprot_entity_mn_comm, 0, eoprot_tag_mn_comm_status);
     eOprotID32_t id2wait = id2send;
     eOmn_comm_status_t brdstatus = {0};
@@ -1137,7 +1423,7 @@ bool EthResource::askBoardVersion(void)
     const double timeout = 0.500;   // 500 ms is more than enough if board is present. if link is not on it is a good time to wait
     const int retries = 20;         // the number of retries depends on the above timeout and on link-up time of the EMS.
 
-    uint32_t signature = 0xaa000000;
+    uint32_t signature = ethQuery->newSignature();
     eOprotID32_t id2send = eoprot_ID_get(eoprot_endpoint_management, eoprot_entity_mn_appl, 0, eoprot_tag_mn_appl_status);
     eOprotID32_t id2wait = id2send;
     eOmn_appl_status_t applstatus = {0};
@@ -1314,7 +1600,7 @@ bool EthResource::verifyRemoteValue(eOprotID32_t id32, void *value, uint16_t siz
 
     char nvinfo[128];
     eoprot_ID2information(id32, nvinfo, sizeof(nvinfo));
-    uint32_t signature = 0xaa000000;
+    uint32_t signature = ethQuery->newSignature();
 
     if((NULL == value) || (0 == size))
     {
@@ -1460,7 +1746,7 @@ bool EthResource::getRemoteValue(eOprotID32_t id32, void *value, uint16_t &size,
 
     char nvinfo[128];
     eoprot_ID2information(id32, nvinfo, sizeof(nvinfo));
-    uint32_t signature = 0xaa000000;
+    uint32_t signature = ethQuery->newSignature();
 
 //    this check is done inside the methods of hostTransceiver class
 //    eOprotBRD_t brd = HostTransceiver::get_protBRDnumber();
@@ -1565,6 +1851,143 @@ bool EthResource::getRemoteValue(eOprotID32_t id32, void *value, uint16_t &size,
 
 }
 
+
+bool EthResource::askRemoteValues(vector<eOprotID32_t> &id32s, vector<void*> &values, vector<uint16_t> &sizes, double timeout, int retries)
+{
+
+#if defined(ETHRES_DEBUG_DONTREADBACK)
+        yWarning() << "EthResource::askRemoteValues() is in ETHRES_DEBUG_DONTREADBACK mode, thus it does not verify";
+        return true;
+#endif
+
+    const size_t numofvalues = id32s.size();
+    const uint32_t signature = ethQuery->newSignature();
+
+    if(numofvalues != values.size())
+    {
+        yError() << "EthResource::askRemoteValues() has" << numofvalues << "ids but" << values.size() << "values for BOARD" << getName() << "with IP" << getIPv4string();
+        return false;
+    }
+
+    sizes.resize(numofvalues);
+    for(size_t n=0; n<numofvalues; n++)
+    {
+        sizes[n] = 0;
+        if(NULL == values[n])
+        {
+            yError() << "EthResource::askRemoteValues() detected NULL value for BOARD" << getName() << "with IP" << getIPv4string();
+            return false;
+        }
+    }
+
+    // we use at most half of the query table for a single call, so that other threads can still query the board
+    const size_t maxchunk = EthNetworkQuery::maxOutstandingQueries / 2;
+
+    double start_time = yarp::os::Time::now();
+    size_t numofreplied = 0;
+    int attempts = 0;
+
+    vector<Semaphore*> sems;
+    vector<bool> replied;
+    vector<eOprotID32_t> id2send;
+    vector<eOprotID32_t> chunkids;
+
+    for(size_t first=0; first<numofvalues; first+=maxchunk)
+    {
+        size_t last = ((first+maxchunk) < numofvalues) ? (first+maxchunk) : (numofvalues);
+        size_t n = last - first;
+
+        replied.assign(n, false);
+        size_t chunkreplied = 0;
+
+        // the semaphores used for waiting for replies from the board. they are reserved all together
+        chunkids.assign(id32s.begin()+first, id32s.begin()+last);
+        ethQuery->start(chunkids, signature, sems);
+
+        for(attempts=0; (attempts<retries) && (chunkreplied<n); attempts++)
+        {
+            // send all the ask messages which did not have a reply yet
+            id2send.clear();
+            for(size_t k=0; k<n; k++)
+            {
+                if(!replied[k])
+                {
+                    id2send.push_back(id32s[first+k]);
+                }
+            }
+
+            if(false == addGetMessagesWithSignature(id2send, signature))
+            {
+                yWarning() << "EthResource::askRemoteValues() cannot transmit the requests to BOARD" << getName() << "with IP" << getIPv4string();
+            }
+
+            // wait for the say messages arriving from the board. all of them share the same deadline
+            double deadline = yarp::os::Time::now() + timeout;
+            for(size_t k=0; k<n; k++)
+            {
+                if(replied[k])
+                {
+                    continue;
+                }
+
+                double remaining = deadline - yarp::os::Time::now();
+                if(remaining < 0)
+                {
+                    remaining = 0;
+                }
+
+                if(true == ethQuery->wait(sems[k], remaining))
+                {
+                    uint16_t ss = 0;
+                    if(false == readBufferedValue(id32s[first+k], (uint8_t*)values[first+k], &ss))
+                    {
+                        yWarning() << "EthResource::askRemoteValues() received a reply from BOARD" << getName() << "with IP" << getIPv4string() << "but cannot read it";
+                    }
+                    else
+                    {
+                        sizes[first+k] = ss;
+                        replied[k] = true;
+                        chunkreplied++;
+                    }
+                }
+            }
+
+            if(chunkreplied < n)
+            {
+                yWarning() << "EthResource::askRemoteValues() has" << n-chunkreplied << "missing replies from BOARD" << getName() << "with IP" << getIPv4string() << "at attempt #" << attempts+1 << "w/ timeout of" << timeout << "seconds";
+            }
+        }
+
+        // must release the semaphores
+        for(size_t k=0; k<n; k++)
+        {
+            ethQuery->stop(sems[k]);
+        }
+
+        numofreplied += chunkreplied;
+
+        if(chunkreplied < n)
+        {
+            break;
+        }
+    }
+
+    double end_time = yarp::os::Time::now();
+
+    if(numofreplied < numofvalues)
+    {
+        yError() << "  FATAL: EthResource::askRemoteValues() DID NOT have" << numofvalues-numofreplied << "replies of" << numofvalues << "from BOARD" << getName() << "with IP" << getIPv4string() << " after" << end_time-start_time << "seconds";
+        return false;
+    }
+
+    if(verbosewhenok)
+    {
+        yDebug() << "EthResource::askRemoteValues() obtained" << numofvalues << "values from BOARD" << getName() << "with IP" << getIPv4string() << "after" << end_time-start_time << "seconds";
+    }
+
+    return true;
+}
+
 bool EthResource::CANPrintHandler(eOmn_info_basic_t *infobasic)
 {
     char str[256];
@@ -149,27 +149,74 @@ public:
 
 // -- class EthNetworkQuery
 // -- it is used to wait for a reply from a board.
+// -- it keeps a table of outstanding queries keyed by (id32, signature), thus many threads can wait for replies at the same time.
+// -- a query with signature zero matches a reply with any signature.
+// -- every query shall use a signature given by newSignature(), so that concurrent queries of the same id32 are released only by their own reply.
+// -- a query can also be asynchronous: a completion function is called when the reply arrives or when its own timeout expires.
 
 class EthNetworkQuery
 {
 
+public:
+
+    enum { maxOutstandingQueries = 64 };
+
+    // the boards echo the signature of an ask<> in their say<>. the top byte tells the rx handlers that the say<> is a reply
+    // to a query, the lower bytes identify the query.
+    static const uint32_t signatureTag  = 0xaa000000;
+    static const uint32_t signatureMask = 0xff000000;
+
+    // it is called when the reply arrives (arrived is true) or when the timeout expires (arrived is false).
+    // it is called by the threads which process the received packets and which transmit them, thus it must be quick and must not block.
+    typedef void (*onCompletion_t)(eOprotID32_t id32, uint32_t signature, bool arrived, void* par);
+
 public:
 
     EthNetworkQuery();
     ~EthNetworkQuery();
 
-    Semaphore* start(eOprotID32_t id32, uint32_t signature);    // associates a semaphore to a (id2wait, signature) pair
+    Semaphore* start(eOprotID32_t id32, uint32_t signature);    // reserves a query for the (id32, signature) pair and gives the semaphore associated to it
+    // it reserves a query for each id32 as a whole (at most maxOutstandingQueries), so that two callers never hold part of what they need each
+    bool start(const vector<eOprotID32_t> &id32s, uint32_t signature, vector<Semaphore*> &sems);
     bool wait(Semaphore* sem, double timeout);                  // waits the semaphore until either a reply arrives or timeout expires (returns false)
-    bool arrived(eOprotID32_t id32, uint32_t signature);        // a reply has arrived. the rx handler must call it. true if it releases, false if not
-    bool stop(Semaphore* sem);                                  // we deassociate the semaphore to the waiting pair
+    bool arrived(eOprotID32_t id32, uint32_t signature);        // a reply has arrived. the rx handler must call it. true if it releases at least a query, false if not
+    bool stop(Semaphore* sem);                                  // we release the query associated to the semaphore
 
-private:
+    uint32_t newSignature(void);                                // it gives a signature which no other outstanding query uses
 
-    eOprotID32_t id2wait;           // the id32 which we wait
-    yarp::os::Semaphore* netwait;   // the semaphore used by the class to wait for a reply from network. it must have exclusive access
-    yarp::os::Semaphore* isbusy;    // the semaphore used to guarantee exclusive access of ::netwait to calling threads
-    yarp::os::Semaphore* iswaiting; // the semaphore used to guarantee that the wait of the class is unblocked only once and when it is required
+    // it reserves an asynchronous query, which is released after oncompletion is called. it does not wait: false if the table is full
+    bool startAsync(eOprotID32_t id32, uint32_t signature, onCompletion_t oncompletion, void* par, double timeout);
+    // it releases an asynchronous query without calling its completion, e.g. when its ask<> could not be transmitted
+    bool cancelAsync(eOprotID32_t id32, uint32_t signature);
+    // it calls oncompletion for the asynchronous queries which have expired and releases them. it must be called periodically.
+    void expire(double now);
 
+    int outstanding(void);
+
+private:
+
+    typedef struct
+    {
+        bool                inuse;
+        eOprotID32_t        id32;
+        uint32_t            signature;
+        yarp::os::Semaphore* netwait;       // the semaphore used to wait for a reply from network
+        bool                async;
+        onCompletion_t      oncompletion;
+        void*               par;
+        double              deadline;
+    } query_t;
+
+    query_t table[maxOutstandingQueries];
+    int numofasync;                   // it lets expire() return quickly when there are no asynchronous queries
+    uint32_t lastSignature;
+    yarp::os::Semaphore* tableLock;   // it protects the table
+    yarp::os::Semaphore* freeSlots;   // it counts the free entries of the table, so that start() waits if all of them are in use
+    yarp::os::Semaphore* reserveLock; // only one thread at a time takes entries from freeSlots, so that reservations of many entries are atomic
+
+    int reserve(eOprotID32_t id32, uint32_t signature);
+    void release(int index);
+    bool matches(int index, eOprotID32_t id32, uint32_t signature);
 };
 
 
@@ -226,6 +273,10 @@ public:
 
     bool getRemoteValue(eOprotID32_t id32, void *value, uint16_t &size, double timeout = 0.100, int retries = 10);
 
+    // it asks many values at the same time: the asks go in the same ropframe and the replies are waited all together.
+    // values[i] must be able to contain the value of id32s[i]. sizes is resized to contain the size of each reply.
+    bool askRemoteValues(vector<eOprotID32_t> &id32s, vector<void*> &values, vector<uint16_t> &sizes, double timeout = 0.100, int retries = 10);
+
 
     // very important note: it works only if there is an handler for the id32 and it manages the unlock of the mutex
     bool setRemoteValueUntilVerified(eOprotID32_t id32, void *value, uint16_t size, int retries = 10, double waitbeforeverification = 0.001, double verificationtimeout = 0.050, int verificationretries = 2);
@@ -235,6 +286,13 @@ public:
 
     bool aNetQueryReplyHasArrived(eOprotID32_t id32, uint32_t signature);
 
+    // it asks a value to the board without waiting for the reply: oncompletion is called when the reply arrives or after timeout
+    // seconds. on arrival the value can be read with readBufferedValue(). it returns false if the ask<> could not be queued.
+    bool askRemoteValueAsync(eOprotID32_t id32, EthNetworkQuery::onCompletion_t oncompletion, void* par, double timeout);
+
+    // it completes the asynchronous queries which have expired. the transmitting thread calls it at every cycle.
+    void expireNetQueries(double now);
+
 
     bool printRXstatistics(void);
     bool CANPrintHandler(eOmn_info_basic_t* infobasic);
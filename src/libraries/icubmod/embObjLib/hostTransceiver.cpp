@@ -465,6 +465,73 @@ bool HostTransceiver::addGetMessageWithSignature(eOprotID32_t id32, uint32_t sig
 }
 
 
+bool HostTransceiver::addGetMessagesWithSignature(const std::vector<eOprotID32_t> &id32s, uint32_t signature)
+{
+    eOresult_t eores = eores_NOK_generic;
+
+    for(size_t n=0; n<id32s.size(); n++)
+    {
+        if(eobool_false == eoprot_id_isvalid(protboardnumber, id32s[n]))
+        {
+            char nvinfo[128];
+            eoprot_ID2information(id32s[n], nvinfo, sizeof(nvinfo));
+            yError() << "HostTransceiver::addGetMessagesWithSignature() called w/ invalid protid: BOARD w/ IP" << remoteipstring <<
+                        "with id: " << nvinfo;
+            return false;
+        }
+    }
+
+    eOropdescriptor_t ropdesc = {0};
+    memcpy(&ropdesc, &eok_ropdesc_basic, sizeof(eOropdescriptor_t));
+    ropdesc.control.plustime    = 1;
+    ropdesc.control.plussign    = (eo_rop_SIGNATUREdummy == signature) ? 0 : 1;
+    ropdesc.ropcode             = eo_ropcode_ask;
+    ropdesc.size                = 0;
+    ropdesc.data                = NULL;
+    ropdesc.signature           = signature;
+
+    size_t loaded = 0;
+
+    for(int i=0; ( (i<maxNumberOfROPloadingAttempts) && (loaded < id32s.size()) ); i++)
+    {
+        size_t loadedbefore = loaded;
+
+        // we keep the lock for the whole sequence, so that the EthSender cannot prepare a ropframe in the middle of it
+        lock_transceiver(true);
+        for(; loaded < id32s.size(); loaded++)
+        {
+            ropdesc.id32 = id32s[loaded];
+            eores = eo_transceiver_OccasionalROP_Load(pc104txrx, &ropdesc);
+            if(eores_OK != eores)
+            {
+                break;
+            }
+        }
+        lock_transceiver(false);
+
+        if(loaded < id32s.size())
+        {
+            // the ropframe is full: we wait for the EthSender to transmit it and then we load the remaining rops.
+            // we count as failed attempts only those which did not load anything
+            if(loaded != loadedbefore)
+            {
+                i = -1;
+            }
+            yarp::os::Time::delay(delayAfterROPloadingFailure);
+        }
+    }
+
+    if(loaded < id32s.size())
+    {
+        yError() << "HostTransceiver::addGetMessagesWithSignature(): ERROR in eo_transceiver_OccasionalROP_Load() for BOARD w/ IP" << remoteipstring << "after all attempts:" <<
+                    "loaded" << loaded << "rops of" << id32s.size();
+        return false;
+    }
+
+    return true;
+}
+
+
 bool HostTransceiver::readBufferedValue(eOprotID32_t id32,  uint8_t *data, uint16_t* size)
 {      
     if(eobool_false == eoprot_id_isvalid(protboardnumber, id32))
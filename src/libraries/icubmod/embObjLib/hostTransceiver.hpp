@@ -49,6 +49,8 @@
 #include <yarp/os/Semaphore.h>
 #include <yarp/dev/DeviceDriver.h>
 
+#include <vector>
+
 using namespace yarp::dev;
 
 
@@ -78,6 +80,10 @@ public:
     bool addGetMessage(eOprotID32_t id32);
     bool addGetMessageWithSignature(eOprotID32_t id32, uint32_t signature);
 
+    // it puts many ask<> ROPs inside the UDP packet. the ROPs are loaded while the transceiver is locked, so that they all go
+    // in the same ropframe unless its capacity is exhausted. in such a case the remaining ones go in the following ropframes.
+    bool addGetMessagesWithSignature(const std::vector<eOprotID32_t> &id32s, uint32_t signature);
+
     // called inside the thread ethReceiver (by a call to TheEthManager::Reception() which calls ... etc.) to process incoming UDP packet.
     // this function processes sig<> ROPs and say<> ROPs and it: 1. writes the received values into internal buffered memory, and
     // 2. calls the relevant callback functions.
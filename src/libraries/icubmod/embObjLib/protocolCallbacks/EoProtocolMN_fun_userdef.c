@@ -112,11 +112,11 @@ extern void eoprot_fun_ONSAY_mn(const EOnv* nv, const eOropdescriptor_t* rd)
     // the aim of this function is to wake up a thread which is blocked because it has sent an ask<id32>
     // the wake up funtionality is implemented in one mode only:
     // a. in initialisation, someone sets some values and then reads them back.
-    //    the read back sends an ask<id32, signature=0xaa000000>. in such a case the board sends back
-    //    a say<id32, data, signature = 0xaa000000>. thus, if the received signature is 0xaa000000, then
+    //    the read back sends an ask<id32, signature=0xaaxxxxxx>, where the lower bytes identify the query. the board sends back
+    //    a say<id32, data, signature = 0xaaxxxxxx>. thus, if the top byte of the received signature is 0xaa, then
     //    we must unblock using feat_signal_network_reply().
 
-    if(0xaa000000 == rd->signature)
+    if(0xaa000000 == (rd->signature & 0xff000000))
     {   // case a:
         if(eobool_false == feat_signal_network_reply(eo_nv_GetIP(nv), rd->id32, rd->signature))
         {
@@ -125,7 +125,7 @@ extern void eoprot_fun_ONSAY_mn(const EOnv* nv, const eOropdescriptor_t* rd)
             char ipinfo[20];
             eoprot_ID2information(rd->id32, nvinfo, sizeof(nvinfo));
             eo_common_ipv4addr_to_string(eo_nv_GetIP(nv), ipinfo, sizeof(ipinfo));
-            snprintf(str, sizeof(str), "eoprot_fun_ONSAY_mn() received an unexpected message w/ 0xaa000000 signature for IP %s and NV %s", ipinfo, nvinfo);
+            snprintf(str, sizeof(str), "eoprot_fun_ONSAY_mn() received an unexpected message w/ 0x%08x signature for IP %s and NV %s", (unsigned int)rd->signature, ipinfo, nvinfo);
             feat_PrintWarning(str);
             return;
        }
@@ -155,7 +155,7 @@ extern void eoprot_fun_UPDT_mn_comm_cmmnds_command_replynumof(const EOnv* nv, co
     // ask<> / say<>.
 
     if(eo_ropcode_sig == rd->ropcode)
-    {   // in here we have a sig and we cannot have the 0xaa000000 signature
+    {   // in here we have a sig and we cannot have a 0xaaxxxxxx signature
         if(eobool_false == feat_signal_network_reply(eo_nv_GetIP(nv), rd->id32, rd->signature))
         {
             feat_PrintError("eoprot_fun_UPDT_mn_comm_cmmnds_command_replynumof() has received an unexpected message");
@@ -173,7 +173,7 @@ extern void eoprot_fun_UPDT_mn_comm_cmmnds_command_replyarray(const EOnv* nv, co
     // ask<> / say<>.
 
     if(eo_ropcode_sig == rd->ropcode)
-    {   // in here we have a sig and we cannot have the 0xaa000000 signature
+    {   // in here we have a sig and we cannot have a 0xaaxxxxxx signature
         if(eobool_false == feat_signal_network_reply(eo_nv_GetIP(nv), rd->id32, rd->signature))
         {
             feat_PrintError("eoprot_fun_UPDT_mn_comm_cmmnds_command_replyarray() has received an unexpected message");
@@ -429,6 +429,7 @@ bool embObjMotionControl::alloc(int nj)
     _axisMap = allocAndCheck<int>(nj);
     _angleToEncoder = allocAndCheck<double>(nj);
     _encodersStamp = allocAndCheck<double>(nj);
+    _statusSnapshot.init(nj);
     _DEPRECATED_encoderconversionoffset = allocAndCheck<float>(nj);
     _DEPRECATED_encoderconversionfactor = allocAndCheck<float>(nj);
     _jointEncoderType = allocAndCheck<uint8_t>(nj);
@@ -495,6 +496,7 @@ bool embObjMotionControl::dealloc()
     checkAndDestroy(_axisMap);
     checkAndDestroy(_angleToEncoder);
     checkAndDestroy(_encodersStamp);
+    _statusSnapshot.release();
     checkAndDestroy(_DEPRECATED_encoderconversionoffset);
     checkAndDestroy(_DEPRECATED_encoderconversionfactor);
     checkAndDestroy(_jointEncoderRes);
@@ -2133,6 +2135,18 @@ bool embObjMotionControl::update(eOprotID32_t id32, double timestamp, void *rxda
         _mutex.wait();
         _encodersStamp[joint] = timestamp;
         _mutex.post();
+
+        // we also refresh the snapshot of the status core used by the multi-joint getters.
+        // the core is taken directly from the received data, so that the rx thread does not lock the buffered values.
+        eOprotTag_t tag = eoprot_ID2tag(id32);
+        if(eoprot_tag_mc_joint_status_core == tag)
+        {
+            _statusSnapshot.write(joint, (eOmc_joint_status_core_t*)rxdata, timestamp);
+        }
+        else if(eoprot_tag_mc_joint_status == tag)
+        {
+            _statusSnapshot.write(joint, &(((eOmc_joint_status_t*)rxdata)->core), timestamp);
+        }
     }
 
     return true;
@@ -2321,39 +2335,59 @@ bool embObjMotionControl::getPidRaw(int j, Pid *pid)
     eOmc_PID_t eoPID;
     res->readBufferedValue(protid, (uint8_t *)&eoPID, &size);
 
-    copyPid_eo2iCub(&eoPID, pid);
+    copyPositionPid_eo2iCub(j, &eoPID, pid);
+
+    return true;
+}
+
+void embObjMotionControl::copyPositionPid_eo2iCub(int j, eOmc_PID_t *in, Pid *out)
+{
+    copyPid_eo2iCub(in, out);
 
     if (_positionControlUnits==P_METRIC_UNITS)
     {
-        pid->kp = pid->kp * _angleToEncoder[j];  //[PWM/deg]
-        pid->ki = pid->ki * _angleToEncoder[j];  //[PWM/deg]
-        pid->kd = pid->kd * _angleToEncoder[j];  //[PWM/deg]
+        out->kp = out->kp * _angleToEncoder[j];  //[PWM/deg]
+        out->ki = out->ki * _angleToEncoder[j];  //[PWM/deg]
+        out->kd = out->kd * _angleToEncoder[j];  //[PWM/deg]
     }
     else if (_positionControlUnits==P_MACHINE_UNITS)
     {
-        pid->kp = pid->kp;  //[PWM/icubdegrees]
-        pid->ki = pid->ki;  //[PWM/icubdegrees]
-        pid->kd = pid->kd;  //[PWM/icubdegrees]
+        out->kp = out->kp;  //[PWM/icubdegrees]
+        out->ki = out->ki;  //[PWM/icubdegrees]
+        out->kd = out->kd;  //[PWM/icubdegrees]
     }
     else
     {
         yError() << "Unknown _positionControlUnits";
     }
-
-    return true;
 }
 
 bool embObjMotionControl::getPidsRaw(Pid *pids)
 {
-    bool ret = true;
+    // the asks for all the joints go in the same ropframe and the replies are waited together, thus we pay one round trip only
+    vector<eOprotID32_t> id32s(_njoints);
+    vector<eOmc_PID_t> eoPIDs(_njoints);
+    vector<void*> values(_njoints);
+    vector<uint16_t> sizes;
 
-    // just one joint at time, wait answer before getting to the next.
-    // This is because otherwise too many msg will be placed into can queue
-    for(int j=0, index=0; j<_njoints; j++, index++)
+    for(int j=0; j<_njoints; j++)
     {
-        ret &=getPidRaw(j, &pids[j]);
+        id32s[j] = eoprot_ID_get(eoprot_endpoint_motioncontrol, eoprot_entity_mc_joint, j, eoprot_tag_mc_joint_config_pidposition);
+        values[j] = &eoPIDs[j];
     }
-    return ret;
+
+    if(false == res->askRemoteValues(id32s, values, sizes))
+    {
+        yError() << "embObjMotionControl::getPidsRaw() could not read the position pids of BOARD" << res->getName() << "IP" << res->getIPv4string();
+        return false;
+    }
+
+    for(int j=0; j<_njoints; j++)
+    {
+        copyPositionPid_eo2iCub(j, &eoPIDs[j], &pids[j]);
+    }
+
+    return true;
 }
 
 bool embObjMotionControl::getReferenceRaw(int j, double *ref)
@@ -3292,8 +3326,29 @@ bool embObjMotionControl::getEncoderRaw(int j, double *value)
     return ret;
 }
 
+static double extractPosition(const eOmc_joint_status_core_t &core)
+{
+    return (double) core.measures.meas_position;
+}
+
+static double extractVelocity(const eOmc_joint_status_core_t &core)
+{
+    return (double) core.measures.meas_velocity;
+}
+
+static double extractAcceleration(const eOmc_joint_status_core_t &core)
+{
+    return (double) core.measures.meas_acceleration;
+}
+
 bool embObjMotionControl::getEncodersRaw(double *encs)
 {
+    // we copy all the joints out of the snapshot without taking any lock. until all joints have been received we use the per joint path
+    if(true == _statusSnapshot.read(extractPosition, encs))
+    {
+        return true;
+    }
+
     bool ret = true;
     for(int j=0; j< _njoints; j++)
     {
@@ -3320,6 +3375,11 @@ bool embObjMotionControl::getEncoderSpeedRaw(int j, double *sp)
 
 bool embObjMotionControl::getEncoderSpeedsRaw(double *spds)
 {
+    if(true == _statusSnapshot.read(extractVelocity, spds))
+    {
+        return true;
+    }
+
     bool ret = true;
     for(int j=0; j< _njoints; j++)
     {
@@ -3344,6 +3404,11 @@ bool embObjMotionControl::getEncoderAccelerationRaw(int j, double *acc)
 
 bool embObjMotionControl::getEncoderAccelerationsRaw(double *accs)
 {
+    if(true == _statusSnapshot.read(extractAcceleration, accs))
+    {
+        return true;
+    }
+
     bool ret = true;
     for(int j=0; j< _njoints; j++)
     {
@@ -3356,6 +3421,12 @@ bool embObjMotionControl::getEncoderAccelerationsRaw(double *accs)
 
 bool embObjMotionControl::getEncodersTimedRaw(double *encs, double *stamps)
 {
+    // values and stamps come from the same snapshot, thus they are coherent and we dont need _mutex
+    if(true == _statusSnapshot.read(extractPosition, encs, stamps))
+    {
+        return true;
+    }
+
     bool ret = getEncodersRaw(encs);
     _mutex.wait();
     for(int i=0; i<_njoints; i++)
@@ -5629,8 +5700,26 @@ bool embObjMotionControl::getOutputRaw(int j, double *out)
 
 }
 
+#if NEW_JSTATUS_STRUCT
+static double extractOutput(const eOmc_joint_status_core_t &core)
+{
+    if((eomc_controlmode_torque == core.modes.controlmodestatus)   ||
+       (eomc_controlmode_current == core.modes.controlmodestatus))
+            return 0;
+
+    return (double) core.ofpid.generic.output;
+}
+#endif
+
 bool embObjMotionControl::getOutputsRaw(double *outs)
 {
+#if NEW_JSTATUS_STRUCT
+    if(true == _statusSnapshot.read(extractOutput, outs))
+    {
+        return true;
+    }
+#endif
+
     bool ret = true;
     for(int j=0; j< _njoints; j++)
     {
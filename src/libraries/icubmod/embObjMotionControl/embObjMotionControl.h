@@ -218,6 +218,108 @@ class torqueControlHelper
     }
 };
 
+#if defined(_MSC_VER)
+#define EMBOBJMC_MEMORY_BARRIER()   MemoryBarrier()
+#else
+#define EMBOBJMC_MEMORY_BARRIER()   __sync_synchronize()
+#endif
+
+// -- class jointStatusSnapshot
+// -- it keeps a copy of the eOmc_joint_status_core_t of every joint of the board together with its reception time.
+// -- it is written only by the thread which receives the packets (see embObjMotionControl::update()) and it is read
+// -- without any lock by the getters: a sequence counter (seqlock) tells the readers if a write happened while they were
+// -- copying, in which case they copy again.
+
+class jointStatusSnapshot
+{
+public:
+    jointStatusSnapshot() : njoints(0), sequence(0), cores(NULL), stamps(NULL), filled(NULL) {}
+    ~jointStatusSnapshot() { release(); }
+
+    void init(int nj)
+    {
+        release();
+        njoints = nj;
+        sequence = 0;
+        cores = new eOmc_joint_status_core_t[nj];
+        stamps = new double[nj];
+        filled = new bool[nj];
+        memset(cores, 0, nj*sizeof(eOmc_joint_status_core_t));
+        for(int j=0; j<nj; j++)
+        {
+            stamps[j] = 0;
+            filled[j] = false;
+        }
+    }
+
+    void release()
+    {
+        if(cores)   delete [] cores;
+        if(stamps)  delete [] stamps;
+        if(filled)  delete [] filled;
+        cores = NULL;
+        stamps = NULL;
+        filled = NULL;
+        njoints = 0;
+    }
+
+    // the only writer is the rx thread
+    inline void write(int j, const eOmc_joint_status_core_t *core, double stamp)
+    {
+        if((j < 0) || (j >= njoints))
+            return;
+        sequence++;
+        EMBOBJMC_MEMORY_BARRIER();
+        memcpy(&cores[j], core, sizeof(eOmc_joint_status_core_t));
+        stamps[j] = stamp;
+        filled[j] = true;
+        EMBOBJMC_MEMORY_BARRIER();
+        sequence++;
+    }
+
+    // it extracts a value from the core of every joint into dest[j]. it returns false if some joint has not been received yet.
+    typedef double (*extractor_t)(const eOmc_joint_status_core_t &core);
+
+    inline bool read(extractor_t extract, double *dest, double *deststamps = NULL)
+    {
+        bool ok = true;
+        uint32_t s0, s1;
+        do
+        {
+            s0 = sequence;
+            EMBOBJMC_MEMORY_BARRIER();
+            if(s0 & 1)
+            {   // a write is in progress
+                s1 = s0 + 1;
+                continue;
+            }
+            ok = true;
+            for(int j=0; j<njoints; j++)
+            {
+                dest[j] = extract(cores[j]);
+                ok = ok && filled[j];
+            }
+            if(NULL != deststamps)
+            {
+                memcpy(deststamps, stamps, njoints*sizeof(double));
+            }
+            EMBOBJMC_MEMORY_BARRIER();
+            s1 = sequence;
+        } while(s0 != s1);
+
+        return ok;
+    }
+
+    inline int size() { return njoints; }
+
+private:
+    int                         njoints;
+    volatile uint32_t           sequence;
+    eOmc_joint_status_core_t    *cores;
+    double                      *stamps;
+    bool                        *filled;
+};
+
 namespace yarp {
     namespace dev  {
     class embObjMotionControl;
@@ -296,6 +398,7 @@ private:
     int *_axisMap;                              /** axis remapping lookup-table */
     double *_angleToEncoder;                    /** angle to iCubDegrees conversion factors */
     double  *_encodersStamp;                    /** keep information about acquisition time for encoders read */
+    jointStatusSnapshot _statusSnapshot;        /** copy of the status core of all joints, read by the multi-joint getters without locks */
     float *_DEPRECATED_encoderconversionfactor;            /** iCubDegrees to encoder conversion factors */
     float *_DEPRECATED_encoderconversionoffset;            /** iCubDegrees offset */
     uint8_t *_jointEncoderType;                 /** joint encoder type*/
@@ -419,6 +522,7 @@ private:
 
     void copyPid_iCub2eo(const Pid *in, eOmc_PID_t *out);
     void copyPid_eo2iCub(eOmc_PID_t *in, Pid *out);
+    void copyPositionPid_eo2iCub(int j, eOmc_PID_t *in, Pid *out);
 
     bool EncoderType_iCub2eo(const string* in, uint8_t *out);
     bool EncoderType_eo2iCub(const uint8_t *in, string* out);
@@ -8,6 +8,7 @@
  */
 
 #include <vector>
+#include <stdint.h>
 
 #include <yarp/os/Time.h>
 #include <yarp/os/Log.h>
@@ -19,6 +20,11 @@
 
 const int CAN_DRIVER_BUFFER_SIZE = 500;
 const int DEFAULT_THREAD_PERIOD = 10;
+
+// one bit of the dispatch table for each access point
+typedef uint64_t apMask_t;
+const int MAX_ACCESS_POINTS = 64;
+
 class SharedCanBus : public yarp::os::RateThread
 {
 public:
@@ -29,8 +35,13 @@ public:
         mDevice="";
 
         reqIdsUnion=new char[0x800];
+        dispatchTable=new apMask_t[0x800];
 
-        for (int i=0; i<0x800; ++i) reqIdsUnion[i]=UNREQ;
+        for (int i=0; i<0x800; ++i)
+        {
+            reqIdsUnion[i]=UNREQ;
+            dispatchTable[i]=0;
+        }
     }
 
     ~SharedCanBus()
@@ -40,6 +51,7 @@ public:
         polyDriver.close();
 
         delete [] reqIdsUnion;
+        delete [] dispatchTable;
     }
 
     int getBufferSize()
@@ -77,11 +89,22 @@ public:
         return mCanDeviceNum==config.find("canDeviceNum").asInt();
     }
 
-    void attachAccessPoint(yarp::dev::CanBusAccessPoint* ap)
+    bool attachAccessPoint(yarp::dev::CanBusAccessPoint* ap)
     {
         configMutex.wait();
+
+        if ((int)accessPoints.size()>=MAX_ACCESS_POINTS)
+        {
+            yError("SharedCanBus: more than %d devices on CAN bus %d, cannot attach more\n", MAX_ACCESS_POINTS, mCanDeviceNum);
+            configMutex.post();
+            return false;
+        }
+
         accessPoints.push_back(ap);
+        rebuildDispatchTableUnsafe();
+
         configMutex.post();
+        return true;
     }
 
     void detachAccessPoint(yarp::dev::CanBusAccessPoint* ap)
@@ -105,6 +128,8 @@ public:
                 
                 accessPoints.pop_back();
 
+                rebuildDispatchTableUnsafe();
+
                 break;
             }
         }
@@ -130,18 +155,7 @@ public:
         {
             for (unsigned int i=0; i<msgsNum; ++i)
             {
-                unsigned int id=readBufferUnion[i].getId();
-
-                for (unsigned int p=0; p<accessPoints.size(); ++p)
-                {
-                    if (accessPoints[p]->hasId(id))
-                    {
-                        if (accessPoints[p]->pushReadMsg(readBufferUnion[i])==false)
-                        {
-                            yError("run()-pushReadMsg() failed on CAN bus %d", mCanDeviceNum);
-                        }
-                    }
-                }
+                dispatchUnsafe(readBufferUnion[i], NULL, "run()");
             }
         } 
 
@@ -153,25 +167,16 @@ public:
         writeMutex.wait();
         bool ret=theCanBus->canWrite(msgs,size,sent,wait);
 
-        //this allows other istances to read back the sent message (echo)
+        //this allows other istances to read back the sent message (echo).
+        //configMutex keeps run() as the only other producer out, so that
+        //the read buffers of the access points have one writer at a time.
+        configMutex.wait();
         yarp::dev::CanBuffer buff=msgs;
         for (unsigned int m=0; m<size; ++m)
         {
-            unsigned int id=buff[m].getId();
-            if (reqIdsUnion[id])
-            {
-                for (unsigned int p=0; p<accessPoints.size(); ++p)
-                {
-                    if (accessPoints[p]!=pFrom && accessPoints[p]->hasId(id))
-                    {
-                        if (accessPoints[p]->pushReadMsg(buff[m])==false)
-                        {
-                            yError("canWrite()-pushReadMsg() failed on CAN bus %d", mCanDeviceNum);
-                        }
-                    }
-                }
-            }
+            dispatchUnsafe(buff[m], pFrom, "canWrite()");
         }
+        configMutex.post();
 
         writeMutex.post();
 
@@ -188,6 +193,8 @@ public:
             theCanBus->canIdAdd(id);
         }
 
+        updateDispatchEntryUnsafe(id);
+
         configMutex.post();
     }
 
@@ -197,6 +204,8 @@ public:
 
         canIdDeleteUnsafe(id);
 
+        updateDispatchEntryUnsafe(id);
+
         configMutex.post();
     }
     
@@ -297,6 +306,48 @@ public:
     }
 
 private:
+    // sends msg to every access point which requested its id, but pFrom
+    void dispatchUnsafe(yarp::dev::CanMessage &msg, yarp::dev::CanBusAccessPoint* pFrom, const char *caller)
+    {
+        unsigned int id=msg.getId();
+        if (id>=0x800) return;
+
+        apMask_t mask=dispatchTable[id];
+
+        for (int p=0; mask; ++p, mask>>=1)
+        {
+            if ((mask & 1) && accessPoints[p]!=pFrom)
+            {
+                if (accessPoints[p]->pushReadMsg(msg)==false)
+                {
+                    yError("%s-pushReadMsg() failed on CAN bus %d", caller, mCanDeviceNum);
+                }
+            }
+        }
+    }
+
+    void updateDispatchEntryUnsafe(unsigned int id)
+    {
+        apMask_t mask=0;
+
+        for (int p=0; p<(int)accessPoints.size(); ++p)
+        {
+            if (accessPoints[p]->hasId(id)) mask|=apMask_t(1)<<p;
+        }
+
+        dispatchTable[id]=mask;
+    }
+
+    // the bits are positional, so the whole table is recomputed
+    // whenever the list of access points changes
+    void rebuildDispatchTableUnsafe()
+    {
+        for (unsigned int id=0; id<0x800; ++id)
+        {
+            updateDispatchEntryUnsafe(id);
+        }
+    }
+
     void canIdDeleteUnsafe(unsigned int id)
     {
         if (reqIdsUnion[id]==REQST)
@@ -334,6 +385,9 @@ private:
     yarp::dev::CanBuffer readBufferUnion;
 
     char *reqIdsUnion; //[0x800];
+
+    // dispatchTable[id] has bit p set if accessPoints[p] requested id
+    apMask_t *dispatchTable; //[0x800];
 };
 
 class SharedCanBusManager // singleton
@@ -413,7 +467,12 @@ bool yarp::dev::CanBusAccessPoint::open(yarp::os::Searchable& config)
 
     readBuffer=createBuffer(mBufferSize);
 
-    mSharedPhysDevice->attachAccessPoint(this);
+    if (!mSharedPhysDevice->attachAccessPoint(this))
+    {
+        destroyBuffer(readBuffer);
+        mSharedPhysDevice=NULL;
+        return false;
+    }
 
     return true;
 }
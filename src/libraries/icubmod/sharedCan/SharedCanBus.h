@@ -40,6 +40,12 @@ namespace yarp{
 
 class SharedCanBus;
 
+#if defined(_MSC_VER)
+#define SHCAN_MEMORY_BARRIER()  MemoryBarrier()
+#else
+#define SHCAN_MEMORY_BARRIER()  __sync_synchronize()
+#endif
+
 class yarp::dev::CanBusAccessPoint : 
     public ICanBus, 
     public ICanBufferFactory,
@@ -58,7 +64,8 @@ public:
 
         mBufferSize=0;
 
-        nRecv=0;
+        rxHead=0;
+        rxTail=0;
     }
 
     ~CanBusAccessPoint()
@@ -73,26 +80,37 @@ public:
         return reqIds[id]==REQST;
     }
 
+    // readBuffer is a single producer single consumer ring: messages are
+    // pushed by the SharedCanBus (always with its configMutex held, so
+    // there is one producer at a time) and popped by canRead(). The
+    // mutexes are touched only to wake up a reader blocked in canRead().
     bool pushReadMsg(CanMessage& msg)
     {
-        synchroMutex.wait();
+        unsigned int tail=rxTail;
 
-        if (nRecv>=mBufferSize)
+        if (tail-rxHead>=mBufferSize)
         {
-            synchroMutex.post();
-            yError("recv buffer overrun (%4d > %4d)", nRecv, mBufferSize);
+            yError("recv buffer overrun (%4d > %4d)", tail-rxHead, mBufferSize);
             return false;
         }
 
-        readBuffer[nRecv++]=msg;
-        
+        readBuffer[tail%mBufferSize]=msg;
+
+        SHCAN_MEMORY_BARRIER();
+        rxTail=tail+1;
+        SHCAN_MEMORY_BARRIER();
+
         if (waitingOnRead)
         {
-            waitingOnRead=false;
-            waitReadMutex.post();
+            synchroMutex.wait();
+            if (waitingOnRead)
+            {
+                waitingOnRead=false;
+                waitReadMutex.post();
+            }
+            synchroMutex.post();
         }
-        
-        synchroMutex.post();
+
         return true;
     }
 
@@ -110,34 +128,39 @@ public:
 
     virtual bool canRead(CanBuffer &msgs, unsigned int size, unsigned int *nmsg, bool wait=false)
     {
-        synchroMutex.wait();
-
-        if (wait && !nRecv)
+        if (wait && rxHead==rxTail)
         {
-            waitingOnRead=true;
-            synchroMutex.post();
-            waitReadMutex.wait();
             synchroMutex.wait();
-        }
-
-        if (nRecv)
-        {
-            for (unsigned int i=0; i<nRecv && i<size; ++i)
+            waitingOnRead=true;
+            SHCAN_MEMORY_BARRIER();
+            if (rxHead==rxTail)
             {
-                msgs[i]=readBuffer[i];
+                synchroMutex.post();
+                waitReadMutex.wait();
+            }
+            else
+            {
+                waitingOnRead=false;
+                synchroMutex.post();
             }
-
-            *nmsg=nRecv;
-            nRecv=0;
-            synchroMutex.post();
-            return true;
         }
-        else
+
+        unsigned int head=rxHead;
+        unsigned int n=rxTail-head;
+        if (n>size) n=size;
+
+        SHCAN_MEMORY_BARRIER();
+
+        for (unsigned int i=0; i<n; ++i)
         {
-            *nmsg=0;
-            synchroMutex.post();
-            return true;
+            msgs[i]=readBuffer[(head+i)%mBufferSize];
         }
+
+        SHCAN_MEMORY_BARRIER();
+        rxHead=head+n;
+
+        *nmsg=n;
+        return true;
     }
 
     virtual bool canWrite(const CanBuffer &msgs, unsigned int size, unsigned int *sent, bool wait=false);
@@ -162,9 +185,11 @@ protected:
     yarp::os::Semaphore waitReadMutex;
     yarp::os::Semaphore synchroMutex;
     
-    bool waitingOnRead;
+    volatile bool waitingOnRead;
 
-    unsigned int nRecv;
+    // free running counters, the slot is counter%mBufferSize
+    volatile unsigned int rxHead;
+    volatile unsigned int rxTail;
     CanBuffer readBuffer;
     
     char *reqIds; //[0x800];
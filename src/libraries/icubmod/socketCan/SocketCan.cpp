@@ -36,9 +36,14 @@
 #include <linux/can/raw.h>
 #include <sys/ioctl.h>
 #include <string.h>
+#include <string>
 #include <stdio.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <linux/net_tstamp.h>
 
 
 /* At time of writing, these constants are not defined in the headers */
@@ -58,9 +63,22 @@ using namespace yarp::os;
 const int TX_QUEUE_SIZE=2047;
 const int RX_QUEUE_SIZE=2047;
 
+// while the tx queue of the interface is full the kernel answers ENOBUFS and
+// poll() reports the socket as writable anyway, so sending is retried with this period.
+// EAGAIN instead means that the socket buffer is full, and poll(POLLOUT) waits for room.
+const int TX_RETRY_PERIOD=1;    // [ms]
+
+// room for the three struct timespec of SCM_TIMESTAMPING
+const int RX_CONTROL_SIZE=CMSG_SPACE(3*sizeof(struct timespec));
+
 SocketCan::SocketCan()
 {
     skt = 0;
+    txTimeout = 500;
+    rxTimeout = 0;
+    txDelay = 0.0;
+    timestamping = false;
+    lastRxTimestamp = 0.0;
 }
 
 SocketCan::~SocketCan()
@@ -68,6 +86,25 @@ SocketCan::~SocketCan()
  
 }
 
+void SocketCan::resizeRX(unsigned int size)
+{
+    if (rxHeaders.size()>=size)
+        return;
+
+    rxHeaders.resize(size);
+    rxVectors.resize(size);
+    rxControl.resize(size*RX_CONTROL_SIZE);
+}
+
+void SocketCan::resizeTX(unsigned int size)
+{
+    if (txHeaders.size()>=size)
+        return;
+
+    txHeaders.resize(size);
+    txVectors.resize(size);
+}
+
 bool SocketCan::canSetBaudRate(unsigned int rate)
 { 
     //not yet implemented
@@ -97,79 +134,92 @@ bool SocketCan::canRead(CanBuffer &msgs,
                      unsigned int *readout,
                      bool wait)
 {
-/*
-    int res;
-    #ifdef WIN32
-        long lRead=size;
-    #else
-        int32_t lRead=size;
+    *readout=0;
+    if (size==0)
+        return true;
+
+    // a blocking read waits only if a timeout was configured, otherwise it
+    // returns the frames already queued, as a non blocking one
+    if (wait && rxTimeout>0)
+    {
+        struct pollfd pfd;
+        pfd.fd=skt;
+        pfd.events=POLLIN;
+        pfd.revents=0;
+        if (poll(&pfd, 1, rxTimeout)<=0)
+            return true;
+    }
+
+    #if SOCK_DEBUG
+        printf("Asked for %d messages\n", size);
     #endif
 
-    CMSG *tmp=reinterpret_cast<CMSG *>(msgs[0].getPointer());
-    if (wait)
-        res=::canRead(*handle, tmp, &lRead, 0);
-    else
-        res=::canTake(*handle, tmp, &lRead);
+    // the frames are received directly into the caller's buffer
+    resizeRX(size);
+    for (unsigned int i=0; i<size; i++)
+    {
+        rxVectors[i].iov_base=msgs[i].getPointer();
+        rxVectors[i].iov_len=sizeof(struct can_frame);
+        struct msghdr &h=rxHeaders[i].msg_hdr;
+        h.msg_name=0;
+        h.msg_namelen=0;
+        h.msg_iov=&rxVectors[i];
+        h.msg_iovlen=1;
+        h.msg_control=timestamping ? &rxControl[i*RX_CONTROL_SIZE] : 0;
+        h.msg_controllen=timestamping ? RX_CONTROL_SIZE : 0;
+        h.msg_flags=0;
+        rxHeaders[i].msg_len=0;
+    }
 
-    *readout=lRead;
+    int n=recvmmsg(skt, &rxHeaders[0], size, MSG_DONTWAIT, 0);
+    if (n<0)
+    {
+        if (errno==EAGAIN || errno==EWOULDBLOCK || errno==EINTR)
+            return true;
+        fprintf(stderr, "Error: SocketCan::canRead() recvmmsg failed: %s\n", strerror(errno));
+        return false;
+    }
 
-    if ( (res==NTCAN_SUCCESS)||(res==NTCAN_RX_TIMEOUT))
+    *readout=n;
+    if (n==0)
         return true;
 
-    fprintf(stderr, "Error: canRead returned with code:%.8X\n", res);*/
+    lastRxTimestamp=Time::now();
+    if (timestamping)
+    {
+        struct msghdr &h=rxHeaders[n-1].msg_hdr;
+        for (struct cmsghdr *c=CMSG_FIRSTHDR(&h); c!=0; c=CMSG_NXTHDR(&h, c))
+        {
+            if (c->cmsg_level==SOL_SOCKET && c->cmsg_type==SCM_TIMESTAMPING)
+            {
+                // [0] is the software stamp, taken with CLOCK_REALTIME: it is
+                // moved to the clock of Time::now() by measuring their offset
+                const struct timespec *ts=(const struct timespec *)CMSG_DATA(c);
+                if (ts[0].tv_sec!=0 || ts[0].tv_nsec!=0)
+                {
+                    struct timespec realNow;
+                    clock_gettime(CLOCK_REALTIME, &realNow);
+                    double age=(realNow.tv_sec-ts[0].tv_sec)+(realNow.tv_nsec-ts[0].tv_nsec)*1e-9;
+                    lastRxTimestamp-=age;
+                }
+            }
+        }
+    }
 
-    int i=0;
-    int bytes_read=0;
     #if SOCK_DEBUG
-        printf("Asked for %d messages\n", size);
-    #endif
-    for (i=0; i<size; i++)
-    {
-        can_frame *frm=reinterpret_cast<can_frame *>(msgs[i].getPointer());
-        //printf("start reading\n");
-        bytes_read = 0;
-        bytes_read = read( skt, frm, sizeof(*frm) );
-        #if SOCK_DEBUG
-            printf("finished reading. read %d bytes\n",bytes_read);
-        #endif
-        if (bytes_read<=0) break;
-
-        #if SOCK_DEBUG
-            printf("Read: %d \n ",bytes_read);
+        for (int i=0; i<n; i++)
+        {
+            can_frame *frm=reinterpret_cast<can_frame *>(msgs[i].getPointer());
             printf("len %d ", frm->can_dlc);
             printf("id %d ", frm->can_id);
             printf("data: ");
             for(int j=0;j<frm->can_dlc;j++)
                 printf("%2x ", frm->data[j]);
             printf("\n");
-        #endif
-
-        //yarp::os::Time::delay(0.010); //test only
-    }
-    *readout=i;
-    #if SOCK_DEBUG
+        }
         printf("Read %d messages\n", *readout);
     #endif
     return true;
-
-	/*
-	//debug
-	//struct can_frame frame;
-    can_frame *frame=reinterpret_cast<can_frame *>(msgs[0].getPointer());
-    bytes_read = read( skt, frame, sizeof(*frame) );
-    *readout=1;
-
-    printf("Read: %d \n ",bytes_read);
-
-    printf("len %d ", frame->can_dlc);
-    printf("id %d ", frame->can_id);
-    printf("data: ");
-    for(i=0;i<frame->can_dlc;i++)
-        printf("%2x ", frame->data[i]);
-    printf("\n");
-
-    return true;
-	*/
 }
 
 bool SocketCan::canWrite(const CanBuffer &msgs,
@@ -177,61 +227,67 @@ bool SocketCan::canWrite(const CanBuffer &msgs,
                       unsigned int *sent,
                       bool wait)
 {
-    int res;
-    int32_t lRead=size;
-    int bytes_sent=0;
+    (*sent)=0;
+    if (size==0)
+        return true;
 
-/*
-    //debug
-    struct can_frame frame2;
-    frame2.can_id = 0x123;
-    strcpy( (char*)(&frame2.data), "YAY" );
-    frame2.can_dlc = strlen( (char*)(&frame2.data) );
-    bytes_sent = write( skt, &frame2, sizeof(frame2) );
-*/
-/*
-    //debug
-    can_frame frame3;
-    frame3.can_id = 0x123;
-    frame3.data[0] = 'Y';
-    frame3.can_dlc = 1;
-    bytes_sent = write( skt, &frame3, sizeof(frame3) );
-*/
+    // optional throttle (CanTxDelay), for setups which still lose frames when
+    // iCubInterface starts and sends the configuration parameters to the boards
+    if (txDelay>0.0)
+        Time::delay(txDelay);
+
+    // the whole buffer is sent with sendmmsg(). when the tx queue of the
+    // interface is full the kernel answers ENOBUFS (or EAGAIN): this is the
+    // backpressure signal, sending is retried until txTimeout expires.
+    CanBuffer &buffer=const_cast<CanBuffer &>(msgs);
+    resizeTX(size);
+    for (unsigned int i=0; i<size; i++)
+    {
+        txVectors[i].iov_base=buffer[i].getPointer();
+        txVectors[i].iov_len=sizeof(struct can_frame);
+        struct msghdr &h=txHeaders[i].msg_hdr;
+        memset(&h, 0, sizeof(h));
+        h.msg_iov=&txVectors[i];
+        h.msg_iovlen=1;
+    }
 
-    //debug
-    //fprintf(stderr, "id:%d data:%d size:%d\n", tmp->can_id, tmp->data[0], tmp->can_dlc );
-   
-    //@@@ IMPORTANT (RANDAZ): I'm putting here a delay of one millisecond.
-	//I noticed that without this delay a lot CAN messages are lost when iCubInterface starts and
-	//sends the configuration parameters (PIDs etc.) to the control boards.
-	//Further investigation is required in order to understand how the internal buffer is handled 
-	//when the function write( skt, tmp, sizeof(*tmp) ); is called.
-	Time::delay(0.001);
-	
-    int i=0;
-	(*sent)=0;
-	for (i=0; i<size; i++)
+    double deadline=Time::now()+txTimeout*0.001;
+    while ((*sent)<size)
     {
-		CanBuffer &buffer=const_cast<CanBuffer &>(msgs);
-		const struct can_frame *tmp=reinterpret_cast<const struct can_frame*>(buffer[i].getPointer());   
-		bytes_sent = write( skt, tmp, sizeof(*tmp) );
-		if (bytes_sent>0) 
-		{
-			(*sent)++;
-		}
+        int n=sendmmsg(skt, &txHeaders[*sent], size-(*sent), MSG_DONTWAIT);
+        if (n>0)
+        {
+            (*sent)+=n;
+            continue;
+        }
+
+        int err=(n<0) ? errno : EAGAIN;
+        if (err!=ENOBUFS && err!=EAGAIN && err!=EWOULDBLOCK && err!=EINTR)
+        {
+            fprintf(stderr, "Error: SocketCan::canWrite() sendmmsg failed: %s\n", strerror(err));
+            break;
+        }
+
+        int remaining=int((deadline-Time::now())*1000.0);
+        if (remaining<=0)
+            break;
+
+        struct pollfd pfd;
+        pfd.fd=skt;
+        pfd.events=POLLOUT;
+        pfd.revents=0;
+        if (err==ENOBUFS)
+            poll(0, 0, (remaining<TX_RETRY_PERIOD) ? remaining : TX_RETRY_PERIOD);
         else
-		{
-			fprintf(stderr, "Error: SocketCan::canWrite() was unable to send message.\n");
-			//break;
-		}
-	}
-	
+            poll(&pfd, 1, remaining);
+    }
+
     if (*sent <size)
-       {
-           fprintf(stderr, "Error: SocketCan::canWrite() not all messages were sent.\n");
-           return false;
-       }
-   
+    {
+        fprintf(stderr, "Error: SocketCan::canWrite() not all messages were sent (%d of %d).\n", *sent, size);
+        return false;
+    }
+
     return true;
 }
 
@@ -240,8 +296,8 @@ bool SocketCan::open(yarp::os::Searchable &par)
     int canTxQueue=TX_QUEUE_SIZE;
     int canRxQueue=RX_QUEUE_SIZE;
     int netId =-1;
-    int txTimeout=500;
-    int rxTimeout=500;
+    txTimeout=500;
+    rxTimeout=0;
 
                          netId=par.check("CanDeviceNum", Value(-1), "numeric identifier of the can device").asInt();
     if  (netId == -1)    netId=par.check("canDeviceNum", Value(-1), "numeric identifier of the can device").asInt();
@@ -249,8 +305,10 @@ bool SocketCan::open(yarp::os::Searchable &par)
                            txTimeout=par.check("CanTxTimeout", Value(500), "timeout on transmission [ms]").asInt();
     if  (txTimeout == 500) txTimeout=par.check("canTxTimeout", Value(500), "timeout on transmission [ms]").asInt();
     
-                           rxTimeout=par.check("CanRxTimeout", Value(500), "timeout on receive when calling blocking read [ms]").asInt() ;
-    if  (rxTimeout == 500) rxTimeout=par.check("canRxTimeout", Value(500), "timeout on receive when calling blocking read [ms]").asInt() ;
+                           rxTimeout=par.check("CanRxTimeout", Value(0), "timeout on receive when calling blocking read [ms], 0 does not block").asInt() ;
+    if  (rxTimeout == 0)   rxTimeout=par.check("canRxTimeout", Value(0), "timeout on receive when calling blocking read [ms], 0 does not block").asInt() ;
+
+    txDelay=par.check("CanTxDelay", Value(0.0), "delay before each write [ms], 0 disables it").asDouble()*0.001;
 
                                       canTxQueue=par.check("CanTxQueue", Value(TX_QUEUE_SIZE), "length of tx buffer").asInt();
     if  (canTxQueue == TX_QUEUE_SIZE) canTxQueue=par.check("canTxQueue", Value(TX_QUEUE_SIZE), "length of tx buffer").asInt();
@@ -258,14 +316,35 @@ bool SocketCan::open(yarp::os::Searchable &par)
                                       canRxQueue=par.check("CanRxQueue", Value(RX_QUEUE_SIZE), "length of rx buffer").asInt() ;
     if  (canRxQueue == RX_QUEUE_SIZE) canRxQueue=par.check("canRxQueue", Value(RX_QUEUE_SIZE), "length of rx buffer").asInt() ;
 
-   int so_timestamping_flags = 0;
+    // the interface name can be given explicitly, e.g. vcan0 for testing
+    std::string devName=par.check("CanDeviceName", Value(""), "name of the socketcan interface (default: can<CanDeviceNum>)").asString().c_str();
+    if (devName.empty())
+    {
+        char tmp[IFNAMSIZ];
+        snprintf(tmp, sizeof(tmp), "can%d", netId);
+        devName=tmp;
+    }
+
    /* Create the socket */
    skt = socket( PF_CAN, SOCK_RAW, CAN_RAW );
+   if (skt<0)
+   {
+       fprintf(stderr, "Error: SocketCan::open() unable to create the socket: %s\n", strerror(errno));
+       skt=0;
+       return false;
+   }
  
    /* Locate the interface you wish to use */
    struct ifreq ifr;
-   sprintf (ifr.ifr_name, "can%d",netId);
-   ioctl(skt, SIOCGIFINDEX, &ifr); // ifr.ifr_ifindex gets filled with that device's index
+   memset(&ifr, 0, sizeof(ifr));
+   strncpy(ifr.ifr_name, devName.c_str(), IFNAMSIZ-1);
+   if (ioctl(skt, SIOCGIFINDEX, &ifr)<0) // ifr.ifr_ifindex gets filled with that device's index
+   {
+       fprintf(stderr, "Error: SocketCan::open() unknown interface %s\n", devName.c_str());
+       ::close(skt);
+       skt=0;
+       return false;
+   }
  
    /* Select that CAN interface, and bind the socket to it. */
    struct sockaddr_can addr;
@@ -277,6 +356,25 @@ bool SocketCan::open(yarp::os::Searchable &par)
     if (-1 == (flags = fcntl(skt, F_GETFL, 0))) flags = 0;
     fcntl(skt, F_SETFL, flags | O_NONBLOCK);
 
+    // the rx queue is sized in frames, the socket buffer in bytes: only
+    // enlarge it, the kernel default is usually already generous
+    int rcvbuf=0;
+    socklen_t len=sizeof(rcvbuf);
+    getsockopt(skt, SOL_SOCKET, SO_RCVBUF, &rcvbuf, &len);
+    if (rcvbuf<int(canRxQueue*sizeof(struct can_frame)))
+    {
+        rcvbuf=canRxQueue*sizeof(struct can_frame);
+        setsockopt(skt, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    }
+
+
+    // only software stamps: the hardware ones count on the clock of the
+    // controller, which cannot be compared with Time::now()
+    int so_timestamping_flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    timestamping = (setsockopt(skt, SOL_SOCKET, SO_TIMESTAMPING, &so_timestamping_flags, sizeof(so_timestamping_flags))==0);
+    if (!timestamping)
+        fprintf(stderr, "Warning: SocketCan::open() kernel timestamps not available on %s\n", devName.c_str());
+
 
    return true;
 }
@@ -300,6 +398,7 @@ bool SocketCan::close()
     if (!skt)
         return false;
 
-    //not yet implemented 
+    ::close(skt);
+    skt=0;
     return true;
 }
@@ -38,6 +38,7 @@
 #include <sys/socket.h>
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <vector>
 
 namespace yarp{
     namespace dev{
@@ -105,6 +106,24 @@ class yarp::dev::SocketCan: public ImplementCanBufferFactory<SocketCanMessage, c
 {
 private:
     int skt;
+    int txTimeout;          /// [ms] max time spent retrying while the tx queue is full
+    int rxTimeout;          /// [ms] max time spent waiting for a frame in a blocking read, 0 does not wait
+    double txDelay;         /// [s] optional delay before each write
+    bool timestamping;      /// true if the kernel attaches a timestamp to the received frames
+
+    // scatter/gather descriptors used by recvmmsg()/sendmmsg(). they point
+    // directly into the CanBuffer passed by the caller, so no frame is copied.
+    std::vector<struct mmsghdr> rxHeaders;
+    std::vector<struct iovec>   rxVectors;
+    std::vector<char>           rxControl;
+    std::vector<struct mmsghdr> txHeaders;
+    std::vector<struct iovec>   txVectors;
+
+    double lastRxTimestamp;
+
+    void resizeRX(unsigned int size);
+    void resizeTX(unsigned int size);
+
 public:
     SocketCan();
     ~SocketCan();
@@ -125,6 +144,13 @@ public:
         unsigned int *sent,
         bool wait=false);
 
+    /**
+     * Timestamp [s] assigned by the kernel to the last frame returned by
+     * canRead(), or the time of the read if kernel timestamps are not available.
+     * In both cases it is expressed in the clock of yarp::os::Time::now().
+     */
+    double getLastRxTimestamp() const { return lastRxTimestamp; }
+
     /*Device Driver*/
     virtual bool open(yarp::os::Searchable &par);
     virtual bool close();
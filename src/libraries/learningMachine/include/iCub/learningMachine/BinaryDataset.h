@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2026 Istituto Italiano di Tecnologia - iCub Facility
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+ */
+
+#ifndef LM_BINARYDATASET__
+#define LM_BINARYDATASET__
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include <yarp/sig/Vector.h>
+
+#include "iCub/learningMachine/IMachineLearner.h"
+
+
+namespace iCub {
+namespace learningmachine {
+
+/**
+ * \ingroup icub_libLM_learning_machines
+ *
+ * Read-only view on a dataset in the binary dataset format. A binary dataset
+ * starts with a 16 byte header, consisting of the magic string "LMDS", a
+ * format version and the number of inputs and outputs as 32 bit unsigned
+ * integers. The header is followed by fixed-width rows, each containing the
+ * inputs and subsequently the outputs of one sample as native doubles. The
+ * number of samples follows from the size of the file.
+ *
+ * On POSIX systems the file is memory-mapped, such that rows can be accessed
+ * directly without parsing or copying the whole file. On other systems the
+ * file is read into memory instead.
+ *
+ * \see iCub::learningmachine::DatasetRecorder
+ *
+ */
+class BinaryDataset {
+private:
+    /**
+     * The filename of the opened dataset.
+     */
+    std::string filename;
+
+    /**
+     * Pointer to the start of the file contents.
+     */
+    const char* base;
+
+    /**
+     * Length of the file contents in bytes.
+     */
+    size_t length;
+
+    /**
+     * Buffer for the file contents if memory-mapping is not available.
+     */
+    std::vector<char> buffer;
+
+    /**
+     * Number of inputs per sample.
+     */
+    unsigned int inputCount;
+
+    /**
+     * Number of outputs per sample.
+     */
+    unsigned int outputCount;
+
+    /**
+     * Number of samples in the dataset.
+     */
+    size_t sampleCount;
+
+    /**
+     * Copy constructor (not implemented).
+     */
+    BinaryDataset(const BinaryDataset& other);
+
+    /**
+     * Assignment operator (not implemented).
+     */
+    BinaryDataset& operator=(const BinaryDataset& other);
+
+public:
+    /**
+     * Magic string at the start of each binary dataset.
+     */
+    static const char MAGIC[4];
+
+    /**
+     * Version of the binary dataset format.
+     */
+    static const unsigned int VERSION = 1;
+
+    /**
+     * Size of the header in bytes.
+     */
+    static const size_t HEADER_SIZE = 16;
+
+    /**
+     * Constructor.
+     */
+    BinaryDataset();
+
+    /**
+     * Constructor that immediately opens a dataset.
+     *
+     * @param filename the filename of the dataset
+     * @exception std::runtime_error if the file is not a valid binary dataset
+     */
+    BinaryDataset(const std::string& filename);
+
+    /**
+     * Destructor.
+     */
+    ~BinaryDataset();
+
+    /**
+     * Opens a binary dataset, closing any previously opened dataset.
+     *
+     * @param filename the filename of the dataset
+     * @exception std::runtime_error if the file is not a valid binary dataset
+     */
+    void open(const std::string& filename);
+
+    /**
+     * Closes the dataset and releases the mapping.
+     */
+    void close();
+
+    /**
+     * Returns true if a dataset has been opened.
+     */
+    bool isOpen() const {
+        return this->base != (const char*) 0;
+    }
+
+    /**
+     * Returns the filename of the opened dataset.
+     */
+    std::string getFilename() const {
+        return this->filename;
+    }
+
+    /**
+     * Returns the number of inputs per sample.
+     */
+    unsigned int getInputCount() const {
+        return this->inputCount;
+    }
+
+    /**
+     * Returns the number of outputs per sample.
+     */
+    unsigned int getOutputCount() const {
+        return this->outputCount;
+    }
+
+    /**
+     * Returns the number of samples in the dataset.
+     */
+    size_t size() const {
+        return this->sampleCount;
+    }
+
+    /**
+     * Returns a pointer to the given row. The inputs are stored first,
+     * directly followed by the outputs. The pointer remains valid until the
+     * dataset is closed.
+     *
+     * @param i the index of the sample
+     */
+    const double* row(size_t i) const {
+        return reinterpret_cast<const double*>(this->base + HEADER_SIZE) +
+               i * (this->inputCount + this->outputCount);
+    }
+
+    /**
+     * Copies a sample into the given input and output vectors.
+     *
+     * @param i the index of the sample
+     * @param input the destination for the inputs
+     * @param output the destination for the outputs
+     * @exception std::runtime_error if the index is out of range
+     */
+    void getSample(size_t i, yarp::sig::Vector& input, yarp::sig::Vector& output) const;
+
+    /**
+     * Feeds a range of samples to a learning machine. The input and output
+     * vectors are allocated once and reused for all samples.
+     *
+     * @param machine the learning machine
+     * @param begin the index of the first sample
+     * @param end one past the index of the last sample
+     */
+    void replay(IMachineLearner& machine, size_t begin, size_t end) const;
+
+    /**
+     * Feeds all samples to a learning machine.
+     *
+     * @param machine the learning machine
+     */
+    void replay(IMachineLearner& machine) const {
+        this->replay(machine, 0, this->sampleCount);
+    }
+
+    /**
+     * Writes the header of a binary dataset to a stream.
+     *
+     * @param stream the (binary) output stream
+     * @param inputCount the number of inputs per sample
+     * @param outputCount the number of outputs per sample
+     */
+    static void writeHeader(std::ostream& stream, unsigned int inputCount, unsigned int outputCount);
+
+    /**
+     * Reads the header of a binary dataset from a memory block.
+     *
+     * @param data pointer to at least HEADER_SIZE bytes
+     * @param inputCount the number of inputs per sample
+     * @param outputCount the number of outputs per sample
+     * @return true if the header is valid
+     */
+    static bool readHeader(const char* data, unsigned int& inputCount, unsigned int& outputCount);
+
+    /**
+     * Writes a single sample of a binary dataset to a stream.
+     *
+     * @param stream the (binary) output stream
+     * @param input the inputs of the sample
+     * @param output the outputs of the sample
+     */
+    static void writeRow(std::ostream& stream, const yarp::sig::Vector& input, const yarp::sig::Vector& output);
+};
+
+} // learningmachine
+} // iCub
+#endif
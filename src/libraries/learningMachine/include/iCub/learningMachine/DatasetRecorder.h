@@ -22,6 +22,7 @@
 #include <fstream>
 
 #include "iCub/learningMachine/IMachineLearner.h"
+#include "iCub/learningMachine/BinaryDataset.h"
 
 
 namespace iCub {
@@ -31,9 +32,11 @@ namespace learningmachine {
  * \ingroup icub_libLM_learning_machines
  *
  * This 'machine learner' demonstrates how the IMachineLearner interface can
- * be used to easily record samples to a file.
+ * be used to easily record samples to a file. Samples are either written as
+ * whitespace separated text or in the binary dataset format.
  *
  * \see iCub::contrib::IMachineLearner
+ * \see iCub::learningmachine::BinaryDataset
  *
  * \author Arjan Gijsberts
  *
@@ -60,11 +63,31 @@ private:
      */
     int sampleCount;
 
+    /**
+     * Whether samples are written in the binary dataset format.
+     */
+    bool binary;
+
+    /**
+     * Number of inputs and outputs of the binary dataset on file.
+     */
+    unsigned int inputCount, outputCount;
+
+    /**
+     * Opens the filestream, writing or validating the header of a binary
+     * dataset.
+     *
+     * @param input the inputs of the first sample
+     * @param output the outputs of the first sample
+     */
+    void openStream(const yarp::sig::Vector& input, const yarp::sig::Vector& output);
+
 public:
     /**
      * Constructor.
      */
-    DatasetRecorder() : filename("dataset.dat"), precision(8), sampleCount(0) {
+    DatasetRecorder() : filename("dataset.dat"), precision(8), sampleCount(0),
+                        binary(false), inputCount(0), outputCount(0) {
         this->setName("Recorder");
     }
 
@@ -73,7 +96,8 @@ public:
      */
     DatasetRecorder(const DatasetRecorder& other)
       : IMachineLearner(other), filename(other.filename),
-        precision(other.precision), sampleCount(other.sampleCount) {
+        precision(other.precision), sampleCount(other.sampleCount),
+        binary(other.binary), inputCount(0), outputCount(0) {
     }
 
     /**
@@ -77,6 +77,15 @@ protected:
      */
     void validateDomainSizes(const yarp::sig::Vector& input, const yarp::sig::Vector& output);
 
+    /**
+     * Validates whether a batch of inputs is of the desired dimensionality and
+     * sizes the matrix of outputs accordingly. An exception will be thrown if
+     * the inputs have the wrong dimensionality.
+     * @param inputs a matrix containing a sample input on each row
+     * @param outputs the matrix of corresponding outputs
+     */
+    void prepareBatch(const yarp::sig::Matrix& inputs, yarp::sig::Matrix& outputs);
+
     /*
      * Inherited from ITransformer.
      */
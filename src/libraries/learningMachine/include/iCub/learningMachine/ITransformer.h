@@ -26,6 +26,7 @@
 #include <yarp/os/Portable.h>
 #include <yarp/os/Bottle.h>
 #include <yarp/sig/Vector.h>
+#include <yarp/sig/Matrix.h>
 
 namespace iCub {
 namespace learningmachine {
@@ -107,6 +108,24 @@ public:
         return yarp::sig::Vector();
     }
 
+    /**
+     * Transforms a batch of input vectors into caller-provided storage. The
+     * default implementation transforms the vectors one at a time.
+     *
+     * @param inputs a matrix containing an input vector on each row
+     * @param outputs a matrix receiving the output vectors on its rows, which
+     *                is resized if necessary
+     */
+    virtual void transformBatch(const yarp::sig::Matrix& inputs, yarp::sig::Matrix& outputs) {
+        for(int r = 0; r < inputs.rows(); r++) {
+            yarp::sig::Vector output = this->transform(inputs.getRow(r));
+            if(outputs.rows() != inputs.rows() || outputs.cols() != (int) output.size()) {
+                outputs.resize(inputs.rows(), output.size());
+            }
+            outputs.setRow(r, output);
+        }
+    }
+
     /**
      * Asks the transformer to return a string containing statistics on its
      * operation so far.
@@ -68,6 +68,15 @@ public:
 
     virtual double evaluate(const yarp::sig::Vector& v1, const yarp::sig::Vector& v2);
 
+    /**
+     * Evaluates the kernel between a vector and each vector of a set.
+     * @param vs the set of vectors
+     * @param v the vector
+     * @param out on output, the kernel evaluations (resized if needed)
+     */
+    virtual void evaluate(const std::vector<yarp::sig::Vector>& vs, const yarp::sig::Vector& v,
+                          yarp::sig::Vector& out);
+
     virtual void setGamma(double g) {
         this->gamma = g;
     }
@@ -112,6 +121,13 @@ public:
  * efficiency the hyperparameters are shared among all outputs. Only the RBF
  * kernel function is supported.
  *
+ * In incremental mode the inverse of the regularized kernel matrix is updated
+ * by bordering whenever a sample is added or removed, so that the model and
+ * the leave-one-out errors are kept up to date at each fed sample. A budget
+ * limits the number of stored samples, discarding the oldest ones (sliding
+ * window). Outside incremental mode the window only slides on train(), so
+ * that the trained coefficients keep matching the stored samples.
+ *
  * \see iCub::contrib::IMachineLearner
  * \see iCub::contrib::IFixedSizeLearner
  *
@@ -155,6 +171,77 @@ private:
      */
     RBFKernel* kernel;
 
+    /**
+     * Whether the model is updated at each fed sample.
+     */
+    bool incremental;
+
+    /**
+     * Maximum number of stored samples (0 means unlimited).
+     */
+    unsigned int budget;
+
+    /**
+     * Inverse of the regularized kernel matrix, i.e. (K + I/C)^-1, maintained
+     * in incremental mode.
+     */
+    yarp::sig::Matrix Hinv;
+
+    /**
+     * Values of C and gamma used to compute the inverse.
+     */
+    double HinvC;
+    double HinvGamma;
+
+    /**
+     * Number of rank-one updates applied to the inverse since it was last
+     * computed from scratch. Once it reaches the number of stored samples the
+     * inverse is recomputed, so that the round-off of the updates cannot
+     * build up while the window slides.
+     */
+    unsigned int HinvUpdates;
+
+    /**
+     * Work buffer for kernel expansions.
+     */
+    yarp::sig::Vector kbuf;
+
+    /**
+     * Returns true if the inverse corresponds to the stored samples and the
+     * current hyperparameters.
+     */
+    bool isInverseValid();
+
+    /**
+     * Computes the inverse from scratch on the stored samples.
+     */
+    void computeInverse();
+
+    /**
+     * Borders the inverse with the last stored sample.
+     */
+    void growInverse();
+
+    /**
+     * Removes the row and column of sample i from the inverse.
+     * @param i the index of the sample
+     */
+    void shrinkInverse(unsigned int i);
+
+    /**
+     * Discards the oldest stored samples in excess of the given number,
+     * keeping the inverse up to date if it is valid.
+     * @param n the number of samples to keep
+     * @returns true if any sample has been discarded
+     */
+    bool discardOldest(unsigned int n);
+
+    /**
+     * Computes the coefficients, the biases and the LOO errors from the
+     * inverse.
+     */
+    void solve();
+
 
 public:
     /**
@@ -259,6 +346,38 @@ public:
         return this->C;
     }
 
+    /**
+     * Mutator for the incremental mode.
+     * @param inc true to update the model at each fed sample
+     */
+    virtual void setIncremental(bool inc) {
+        this->incremental = inc;
+    }
+
+    /**
+     * Accessor for the incremental mode.
+     * @returns true if the model is updated at each fed sample
+     */
+    virtual bool getIncremental() {
+        return this->incremental;
+    }
+
+    /**
+     * Mutator for the budget, i.e. the maximum number of stored samples. When
+     * exceeded, the oldest samples are discarded, immediately in incremental
+     * mode and on the next train() otherwise.
+     * @param b the new value (0 means unlimited)
+     */
+    virtual void setBudget(unsigned int b);
+
+    /**
+     * Accessor for the budget.
+     * @returns the maximum number of stored samples
+     */
+    virtual unsigned int getBudget() {
+        return this->budget;
+    }
+
     /**
      * Accessor for the kernel.
      *
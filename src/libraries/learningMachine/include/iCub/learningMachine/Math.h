@@ -111,6 +111,28 @@ void cholupdate(yarp::sig::Matrix& R, const yarp::sig::Vector& x, yarp::sig::Vec
  */
 void cholupdate(yarp::sig::Matrix& R, const yarp::sig::Vector& x, bool rtrans = 0);
 
+/**
+ * Perform a rank-k update to a Cholesky factor, i.e. R'R + X'X, without any
+ * memory allocation. Only the upper triangle of R is updated; use
+ * cholreflect() before passing R to the solvers.
+ *
+ * @param R  an upper triangular Cholesky factor (p x p)
+ * @param X  a matrix containing the k update vectors on its rows (k x p)
+ * @param work  a work vector of size p
+ * @param c  a work vector of size p, on output the cosines of the last update
+ * @param s  a work vector of size p, on output the sines of the last update
+ */
+void cholupdate(yarp::sig::Matrix& R, const yarp::sig::Matrix& X, yarp::sig::Vector& work,
+                yarp::sig::Vector& c, yarp::sig::Vector& s);
+
+/**
+ * Copies the upper triangle of a Cholesky factor onto its lower triangle, as
+ * the GSL routines expect duplicate information.
+ *
+ * @param R  an upper triangular Cholesky factor
+ */
+void cholreflect(yarp::sig::Matrix& R);
+
 /**
  * Solves a system A*x=b for multiple row vectors in B using a precomputed
  * Cholesky factor R.
@@ -33,7 +33,9 @@ namespace learningmachine {
  *
  * Recursive Regularized Least Squares (a.k.a. ridge regression) learner. It
  * uses a rank 1 update rule to update the Cholesky factor of the covariance
- * matrix.
+ * matrix, or a rank k update when a batch of samples is fed at once. The
+ * weight matrix is recomputed lazily, i.e. on prediction or every number of
+ * samples set by the refresh interval.
  *
  * \see iCub::learningmachine::IMachineLearner
  * \see iCub::learningmachine::IFixedSizeLearner
@@ -70,6 +72,37 @@ private:
      */
     double lambda;
 
+    /**
+     * Number of samples fed since the weight matrix has been computed.
+     */
+    int pendingCount;
+
+    /**
+     * Number of samples after which the weight matrix is recomputed (0 means
+     * only when needed for prediction).
+     */
+    int refreshInterval;
+
+    /**
+     * Work buffers for the Cholesky updates.
+     */
+    yarp::sig::Matrix x;
+    yarp::sig::Vector work;
+    yarp::sig::Vector c;
+    yarp::sig::Vector s;
+
+    /**
+     * Recomputes the weight matrix if samples have been fed since the last
+     * computation.
+     */
+    void updateWeights();
+
+    /**
+     * Accounts for n newly fed samples and recomputes the weight matrix if
+     * the refresh interval has been reached.
+     */
+    void samplesFed(int n);
+
 public:
     /**
      * Constructor.
@@ -100,6 +133,14 @@ public:
      */
     virtual void feedSample(const yarp::sig::Vector& input, const yarp::sig::Vector& output);
 
+    /**
+     * Feeds a batch of samples at once, using a rank k update of the Cholesky
+     * factor.
+     * @param inputs a matrix containing an input sample on each row
+     * @param outputs a matrix containing the corresponding output samples
+     */
+    virtual void feedSamples(const yarp::sig::Matrix& inputs, const yarp::sig::Matrix& outputs);
+
     /*
      * Inherited from IMachineLearner.
      */
@@ -167,6 +208,19 @@ public:
      */
     double getLambda();
 
+    /**
+     * Sets the number of samples after which the weight matrix is recomputed.
+     * A value of 0 postpones the computation until the next prediction.
+     * @param k the desired number of samples.
+     */
+    void setRefreshInterval(int k);
+
+    /**
+     * Accessor for the refresh interval of the weight matrix.
+     * @returns the number of samples
+     */
+    int getRefreshInterval();
+
     /*
      * Inherited from IConfig.
      */
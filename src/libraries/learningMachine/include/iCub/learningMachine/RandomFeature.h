@@ -59,6 +59,13 @@ protected:
      */
     yarp::sig::Vector b;
 
+    /**
+     * Turns the projections held in an output vector into the cosine
+     * features.
+     * @param out the output vector, holding the projections on input
+     */
+    void expand(double* out);
+
     /*
      * Inherited from ITransformer.
      */
@@ -96,6 +103,17 @@ public:
      */
     virtual yarp::sig::Vector transform(const yarp::sig::Vector& input);
 
+    /**
+     * Transforms a batch of input vectors at once. The projections of all
+     * inputs are computed with a single matrix-matrix product and the
+     * result is written directly into the output matrix.
+     *
+     * @param inputs a matrix containing an input vector on each row
+     * @param outputs a matrix receiving the output vectors on its rows, which
+     *                is resized if necessary
+     */
+    virtual void transformBatch(const yarp::sig::Matrix& inputs, yarp::sig::Matrix& outputs);
+
     /*
      * Inherited from ITransformer.
      */
@@ -62,6 +62,14 @@ protected:
      */
     yarp::sig::Matrix W;
 
+    /**
+     * Expands the projections held in the first half of an output vector
+     * into the cosine and sine features.
+     * @param out the output vector, holding the projections on input
+     * @param nproj the number of projections
+     */
+    void expand(double* out, int nproj);
+
     /*
      * Inherited from ITransformer.
      */
@@ -101,6 +109,17 @@ public:
      */
     virtual yarp::sig::Vector transform(const yarp::sig::Vector& input);
 
+    /**
+     * Transforms a batch of input vectors at once. The projections of all
+     * inputs are computed with a single matrix-matrix product and the
+     * result is written directly into the output matrix.
+     *
+     * @param inputs a matrix containing an input vector on each row
+     * @param outputs a matrix receiving the output vectors on its rows, which
+     *                is resized if necessary
+     */
+    virtual void transformBatch(const yarp::sig::Matrix& inputs, yarp::sig::Matrix& outputs);
+
     /*
      * Inherited from ITransformer.
      */
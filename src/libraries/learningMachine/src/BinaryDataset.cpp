@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026 Istituto Italiano di Tecnologia - iCub Facility
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+ */
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define LM_BINARYDATASET_MMAP
+#endif
+
+#include "iCub/learningMachine/BinaryDataset.h"
+
+namespace iCub {
+namespace learningmachine {
+
+const char BinaryDataset::MAGIC[4] = { 'L', 'M', 'D', 'S' };
+const unsigned int BinaryDataset::VERSION;
+const size_t BinaryDataset::HEADER_SIZE;
+
+BinaryDataset::BinaryDataset()
+  : filename(""), base((const char*) 0), length(0), inputCount(0),
+    outputCount(0), sampleCount(0) {
+}
+
+BinaryDataset::BinaryDataset(const std::string& filename)
+  : filename(""), base((const char*) 0), length(0), inputCount(0),
+    outputCount(0), sampleCount(0) {
+    this->open(filename);
+}
+
+BinaryDataset::~BinaryDataset() {
+    this->close();
+}
+
+void BinaryDataset::open(const std::string& filename) {
+    this->close();
+
+#ifdef LM_BINARYDATASET_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if(fd < 0) {
+        throw std::runtime_error("could not open file '" + filename + "'");
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0 || size_t(st.st_size) < HEADER_SIZE) {
+        ::close(fd);
+        throw std::runtime_error("file '" + filename + "' is not a binary dataset");
+    }
+    void* addr = mmap(0, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping stays valid after closing the descriptor
+    ::close(fd);
+    if(addr == MAP_FAILED) {
+        throw std::runtime_error("could not map file '" + filename + "'");
+    }
+    // samples are typically replayed front to back
+    madvise(addr, size_t(st.st_size), MADV_SEQUENTIAL);
+    this->base = static_cast<const char*>(addr);
+    this->length = size_t(st.st_size);
+#else
+    std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+    if(!stream.is_open()) {
+        throw std::runtime_error("could not open file '" + filename + "'");
+    }
+    stream.seekg(0, std::ios::end);
+    size_t len = size_t(stream.tellg());
+    stream.seekg(0, std::ios::beg);
+    if(len < HEADER_SIZE) {
+        throw std::runtime_error("file '" + filename + "' is not a binary dataset");
+    }
+    this->buffer.resize(len);
+    stream.read(&this->buffer[0], len);
+    this->base = &this->buffer[0];
+    this->length = len;
+#endif
+
+    if(!readHeader(this->base, this->inputCount, this->outputCount)) {
+        this->close();
+        throw std::runtime_error("file '" + filename + "' is not a binary dataset");
+    }
+
+    size_t rowSize = (this->inputCount + this->outputCount) * sizeof(double);
+    this->sampleCount = (rowSize > 0) ? (this->length - HEADER_SIZE) / rowSize : 0;
+    this->filename = filename;
+}
+
+void BinaryDataset::close() {
+#ifdef LM_BINARYDATASET_MMAP
+    if(this->base != (const char*) 0) {
+        munmap(const_cast<char*>(this->base), this->length);
+    }
+#else
+    this->buffer.clear();
+#endif
+    this->base = (const char*) 0;
+    this->length = 0;
+    this->inputCount = 0;
+    this->outputCount = 0;
+    this->sampleCount = 0;
+    this->filename = "";
+}
+
+void BinaryDataset::getSample(size_t i, yarp::sig::Vector& input, yarp::sig::Vector& output) const {
+    if(i >= this->sampleCount) {
+        throw std::runtime_error("sample index out of range");
+    }
+    if(input.size() != this->inputCount) {
+        input.resize(this->inputCount);
+    }
+    if(output.size() != this->outputCount) {
+        output.resize(this->outputCount);
+    }
+
+    const double* r = this->row(i);
+    if(this->inputCount > 0) {
+        std::memcpy(input.data(), r, this->inputCount * sizeof(double));
+    }
+    if(this->outputCount > 0) {
+        std::memcpy(output.data(), r + this->inputCount, this->outputCount * sizeof(double));
+    }
+}
+
+void BinaryDataset::replay(IMachineLearner& machine, size_t begin, size_t end) const {
+    if(end > this->sampleCount) {
+        end = this->sampleCount;
+    }
+
+    yarp::sig::Vector input(this->inputCount);
+    yarp::sig::Vector output(this->outputCount);
+    for(size_t i = begin; i < end; i++) {
+        this->getSample(i, input, output);
+        machine.feedSample(input, output);
+    }
+}
+
+void BinaryDataset::writeHeader(std::ostream& stream, unsigned int inputCount, unsigned int outputCount) {
+    char header[HEADER_SIZE];
+    unsigned int fields[3] = { VERSION, inputCount, outputCount };
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    std::memcpy(header + sizeof(MAGIC), fields, sizeof(fields));
+    stream.write(header, HEADER_SIZE);
+}
+
+bool BinaryDataset::readHeader(const char* data, unsigned int& inputCount, unsigned int& outputCount) {
+    unsigned int fields[3];
+    if(std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    std::memcpy(fields, data + sizeof(MAGIC), sizeof(fields));
+    if(fields[0] != VERSION) {
+        return false;
+    }
+    inputCount = fields[1];
+    outputCount = fields[2];
+    return true;
+}
+
+void BinaryDataset::writeRow(std::ostream& stream, const yarp::sig::Vector& input, const yarp::sig::Vector& output) {
+    if(input.size() > 0) {
+        stream.write(reinterpret_cast<const char*>(input.data()), input.size() * sizeof(double));
+    }
+    if(output.size() > 0) {
+        stream.write(reinterpret_cast<const char*>(output.data()), output.size() * sizeof(double));
+    }
+}
+
+} // learningmachine
+} // iCub
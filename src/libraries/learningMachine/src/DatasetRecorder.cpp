@@ -18,6 +18,7 @@
 
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 
 #include "iCub/learningMachine/DatasetRecorder.h"
 
@@ -31,18 +32,58 @@ DatasetRecorder& DatasetRecorder::operator=(const DatasetRecorder& other) {
     this->filename = other.filename;
     this->precision = other.precision;
     this->sampleCount = other.sampleCount;
+    this->binary = other.binary;
 
     return *this;
 }
 
-
-void DatasetRecorder::feedSample(const yarp::sig::Vector& input, const yarp::sig::Vector& output) {
-    // open stream if not opened yet
-    if(!this->stream.is_open()) {
+void DatasetRecorder::openStream(const yarp::sig::Vector& input, const yarp::sig::Vector& output) {
+    if(!this->binary) {
         // perhaps check if file already exists
         this->stream.open(this->filename.c_str(), std::ios_base::out | std::ios_base::app);
         // set precision
         this->stream.precision(this->precision);
+        return;
+    }
+
+    // check for an existing binary dataset to append to
+    std::ifstream existing(this->filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    char header[BinaryDataset::HEADER_SIZE];
+    bool append = existing.is_open() &&
+                  existing.read(header, BinaryDataset::HEADER_SIZE).gcount() == std::streamsize(BinaryDataset::HEADER_SIZE);
+    existing.close();
+
+    if(append) {
+        if(!BinaryDataset::readHeader(header, this->inputCount, this->outputCount)) {
+            throw std::runtime_error("file '" + this->filename + "' is not a binary dataset");
+        }
+        if(this->inputCount != input.size() || this->outputCount != output.size()) {
+            throw std::runtime_error("sample dimensions do not match binary dataset on file");
+        }
+        this->stream.open(this->filename.c_str(), std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+    } else {
+        this->inputCount = input.size();
+        this->outputCount = output.size();
+        this->stream.open(this->filename.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+        BinaryDataset::writeHeader(this->stream, this->inputCount, this->outputCount);
+    }
+}
+
+void DatasetRecorder::feedSample(const yarp::sig::Vector& input, const yarp::sig::Vector& output) {
+    // open stream if not opened yet
+    if(!this->stream.is_open()) {
+        this->openStream(input, output);
+    }
+
+    if(this->binary) {
+        // rows in a binary dataset have a fixed width
+        if(this->inputCount != input.size() || this->outputCount != output.size()) {
+            throw std::runtime_error("sample dimensions do not match binary dataset");
+        }
+        BinaryDataset::writeRow(this->stream, input, output);
+        this->sampleCount++;
+        this->stream.flush();
+        return;
     }
 
     // first write inputs
@@ -70,6 +111,7 @@ std::string DatasetRecorder::getInfo() {
     buffer << this->IMachineLearner::getInfo();
     buffer << "Filename: " << this->filename << std::endl;
     buffer << "Precision: " << this->precision << std::endl;
+    buffer << "Format: " << (this->binary ? "binary" : "text") << std::endl;
     buffer << "Sample Count: " << this->sampleCount << std::endl;
     return buffer.str();
 }
@@ -77,9 +119,12 @@ std::string DatasetRecorder::getInfo() {
 void DatasetRecorder::writeBottle(yarp::os::Bottle& bot) {
     bot.addString(this->filename.c_str());
     bot.addInt(this->precision);
+    bot.addInt(this->binary);
 }
 
 void DatasetRecorder::readBottle(yarp::os::Bottle& bot) {
+    // the format is appended last and absent in older serializations
+    this->binary = (bot.size() > 2) ? (bot.pop().asInt() != 0) : false;
     this->precision = bot.pop().asInt();
     this->filename = bot.pop().asString().c_str();
 }
@@ -89,6 +134,7 @@ std::string DatasetRecorder::getConfigHelp() {
     buffer << this->IMachineLearner::getConfigHelp();
     buffer << "  filename name         Filename to write to" << std::endl;
     buffer << "  precision n           Number of digits precision for doubles" << std::endl;
+    buffer << "  format text|binary    Write text or binary datasets" << std::endl;
     return buffer.str();
 }
 
@@ -108,6 +154,17 @@ bool DatasetRecorder::configure(yarp::os::Searchable& config) {
         success = true;
     }
 
+    // set the output format
+    if(config.find("format").asString() == "text") {
+        this->reset();
+        this->binary = false;
+        success = true;
+    } else if(config.find("format").asString() == "binary") {
+        this->reset();
+        this->binary = true;
+        success = true;
+    }
+
     return success;
 }
 
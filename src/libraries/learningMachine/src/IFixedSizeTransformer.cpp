@@ -40,6 +40,16 @@ void IFixedSizeTransformer::validateDomainSizes(const yarp::sig::Vector& input,
     }
 }
 
+void IFixedSizeTransformer::prepareBatch(const yarp::sig::Matrix& inputs, yarp::sig::Matrix& outputs) {
+    if(inputs.cols() != (int) this->getDomainSize()) {
+        throw std::runtime_error("Input sample has invalid dimensionality");
+    }
+    if(outputs.rows() != inputs.rows() || outputs.cols() != (int) this->getCoDomainSize()) {
+        outputs.resize(inputs.rows(), this->getCoDomainSize());
+    }
+    this->sampleCount += inputs.rows();
+}
+
 bool IFixedSizeTransformer::configure(yarp::os::Searchable& config) {
     bool success = false;
     // set the domain size (int)
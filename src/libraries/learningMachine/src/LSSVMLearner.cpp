@@ -18,6 +18,7 @@
 
 #include <cassert>
 #include <sstream>
+#include <algorithm>
 #include <cmath>
 
 #include <yarp/math/Math.h>
@@ -45,10 +46,40 @@ double RBFKernel::evaluate(const yarp::sig::Vector& v1, const yarp::sig::Vector&
     return std::exp(result);
 }
 
+void RBFKernel::evaluate(const std::vector<yarp::sig::Vector>& vs, const yarp::sig::Vector& v,
+                         yarp::sig::Vector& out) {
+    size_t d = v.size();
+    const double* vp = v.data();
+
+    if(out.size() != vs.size()) {
+        out.resize(vs.size());
+    }
+
+    // squared distances first, exponentials in a separate sweep
+    for(size_t i = 0; i < vs.size(); i++) {
+        assert(vs[i].size() == d);
+        const double* vip = vs[i].data();
+        double result = 0.0;
+        for(size_t j = 0; j < d; j++) {
+            double diff = vip[j] - vp[j];
+            result += diff * diff;
+        }
+        out(i) = result;
+    }
+
+    for(size_t i = 0; i < out.size(); i++) {
+        out(i) = std::exp(-1 * this->gamma * out(i));
+    }
+}
+
 
 LSSVMLearner::LSSVMLearner(unsigned int dom, unsigned int cod, double c) {
     this->setName("LSSVM");
     this->kernel = new RBFKernel();
+    this->incremental = false;
+    this->budget = 0;
+    this->HinvC = this->HinvGamma = 0.0;
+    this->HinvUpdates = 0;
     // make sure to not use initialization list to constructor of base for
     // domain and codomain size, as it will not use overloaded mutators
     this->setDomainSize(dom);
@@ -59,7 +90,9 @@ LSSVMLearner::LSSVMLearner(unsigned int dom, unsigned int cod, double c) {
 LSSVMLearner::LSSVMLearner(const LSSVMLearner& other)
   : IFixedSizeLearner(other), inputs(other.inputs), outputs(other.outputs),
     alphas(other.alphas), bias(other.bias), LOO(other.LOO), C(other.C),
-    kernel(new RBFKernel(*other.kernel)) {
+    kernel(new RBFKernel(*other.kernel)), incremental(other.incremental),
+    budget(other.budget), Hinv(other.Hinv), HinvC(other.HinvC),
+    HinvGamma(other.HinvGamma), HinvUpdates(other.HinvUpdates) {
 
 }
 
@@ -79,6 +112,12 @@ LSSVMLearner& LSSVMLearner::operator=(const LSSVMLearner& other) {
     this->C = other.C;
     delete this->kernel;
     this->kernel = new RBFKernel(*other.kernel);
+    this->incremental = other.incremental;
+    this->budget = other.budget;
+    this->Hinv = other.Hinv;
+    this->HinvC = other.HinvC;
+    this->HinvGamma = other.HinvGamma;
+    this->HinvUpdates = other.HinvUpdates;
 
     return *this;
 }
@@ -87,18 +126,207 @@ void LSSVMLearner::feedSample(const yarp::sig::Vector& input, const yarp::sig::V
     // call parent method to let it do some validation for us
     this->IFixedSizeLearner::feedSample(input, output);
 
+    // sliding window: discard the oldest samples, but only when the model
+    // follows the window; otherwise the trained coefficients would no longer
+    // match the stored samples and the window slides on train()
+    bool valid = false;
+    if(this->incremental) {
+        if(this->budget > 0) {
+            this->discardOldest(this->budget - 1);
+        }
+        valid = this->isInverseValid();
+    }
+
     this->inputs.push_back(input);
     this->outputs.push_back(output);
+
+    if(this->incremental) {
+        if(valid && this->HinvUpdates < this->inputs.size()) {
+            this->growInverse();
+        } else {
+            this->computeInverse();
+        }
+        this->solve();
+    }
+}
+
+bool LSSVMLearner::isInverseValid() {
+    return (this->Hinv.rows() == (int) this->inputs.size() && this->HinvC == this->C &&
+            this->HinvGamma == this->kernel->getGamma());
+}
+
+void LSSVMLearner::computeInverse() {
+    int n = this->inputs.size();
+
+    // regularized kernel matrix
+    yarp::sig::Matrix H(n, n);
+    for(int r = 0; r < n; r++) {
+        // symmetric matrix
+        for(int c = 0; c <= r; c++) {
+            H(r, c) = H(c, r) = this->kernel->evaluate(this->inputs[r], this->inputs[c]);
+            if(r == c) H(r, c) += (1.0 / this->C);
+        }
+    }
+
+    this->Hinv = (n > 0) ? luinv(H) : H;
+    this->HinvC = this->C;
+    this->HinvGamma = this->kernel->getGamma();
+    this->HinvUpdates = 0;
+}
+
+void LSSVMLearner::growInverse() {
+    int n = this->inputs.size() - 1;
+
+    // kernel expansion of the new sample against all samples (itself last)
+    this->kernel->evaluate(this->inputs, this->inputs.back(), this->kbuf);
+
+    // u = Hinv * k, sigma = h - k' * u (Schur complement)
+    yarp::sig::Vector u(n);
+    double sigma = this->kbuf(n) + (1.0 / this->C);
+    for(int r = 0; r < n; r++) {
+        u(r) = 0.0;
+        for(int c = 0; c < n; c++) {
+            u(r) += this->Hinv(r, c) * this->kbuf(c);
+        }
+        sigma -= this->kbuf(r) * u(r);
+    }
+
+    yarp::sig::Matrix G(n + 1, n + 1);
+    for(int r = 0; r < n; r++) {
+        for(int c = 0; c < n; c++) {
+            G(r, c) = this->Hinv(r, c) + u(r) * u(c) / sigma;
+        }
+        G(r, n) = G(n, r) = -u(r) / sigma;
+    }
+    G(n, n) = 1.0 / sigma;
+
+    this->Hinv = G;
+    this->HinvUpdates++;
+}
+
+void LSSVMLearner::shrinkInverse(unsigned int i) {
+    int n = this->Hinv.rows();
+    int j = i;
+    double a = this->Hinv(j, j);
+
+    // inverse of the remaining block: Q - q * q' / a
+    yarp::sig::Matrix G(n - 1, n - 1);
+    for(int r = 0, gr = 0; r < n; r++) {
+        if(r == j) continue;
+        for(int c = 0, gc = 0; c < n; c++) {
+            if(c == j) continue;
+            G(gr, gc) = this->Hinv(r, c) - this->Hinv(r, j) * this->Hinv(j, c) / a;
+            gc++;
+        }
+        gr++;
+    }
+
+    this->Hinv = G;
+    this->HinvUpdates++;
+}
+
+bool LSSVMLearner::discardOldest(unsigned int n) {
+    if(this->inputs.size() <= n) {
+        return false;
+    }
+
+    unsigned int excess = this->inputs.size() - n;
+    bool valid = this->isInverseValid();
+    this->inputs.erase(this->inputs.begin(), this->inputs.begin() + excess);
+    this->outputs.erase(this->outputs.begin(), this->outputs.begin() + excess);
+    if(valid) {
+        for(unsigned int i = 0; i < excess; i++) {
+            this->shrinkInverse(0);
+        }
+    }
+    return true;
+}
+
+void LSSVMLearner::solve() {
+    int n = this->Hinv.rows();
+    int m = this->getCoDomainSize();
+
+    if(n == 0) {
+        return;
+    }
+
+    // eta = Hinv * 1, s = 1' * eta
+    yarp::sig::Vector eta(n);
+    double s = 0.0;
+    for(int r = 0; r < n; r++) {
+        eta(r) = 0.0;
+        for(int c = 0; c < n; c++) {
+            eta(r) += this->Hinv(r, c);
+        }
+        s += eta(r);
+    }
+
+    // the diagonal of the inverse of the bordered kernel matrix
+    yarp::sig::Vector d(n);
+    for(int r = 0; r < n; r++) {
+        d(r) = this->Hinv(r, r) - eta(r) * eta(r) / s;
+    }
+
+    this->alphas.resize(n, m);
+    this->bias.resize(m);
+    this->LOO = zeros(m);
+
+    yarp::sig::Vector nu(n);
+    for(int i = 0; i < m; i++) {
+        // nu = Hinv * y, b = 1' * nu / s, alpha = nu - eta * b
+        double b = 0.0;
+        for(int r = 0; r < n; r++) {
+            nu(r) = 0.0;
+            for(int c = 0; c < n; c++) {
+                nu(r) += this->Hinv(r, c) * this->outputs[c](i);
+            }
+            b += nu(r);
+        }
+        b /= s;
+
+        this->bias(i) = b;
+        for(int r = 0; r < n; r++) {
+            this->alphas(r, i) = nu(r) - eta(r) * b;
+            double err = this->alphas(r, i) / d(r);
+            this->LOO(i) += err * err;
+        }
+        this->LOO(i) /= n;
+    }
+}
+
+void LSSVMLearner::setBudget(unsigned int b) {
+    this->budget = b;
+
+    // discard the oldest samples in excess (see train() for the batch mode)
+    if(this->incremental && this->budget > 0 && this->discardOldest(this->budget)) {
+        if(this->isInverseValid()) {
+            this->solve();
+        }
+    }
 }
 
 void LSSVMLearner::train() {
     assert(this->inputs.size() == this->outputs.size());
 
+    // sliding window: only the last samples within the budget are trained
+    bool slid = (this->budget > 0) && this->discardOldest(this->budget);
+
     // save wasting some time
     if(inputs.size() == 0) {
         return;
     }
 
+    // the incremental model is up to date, unless the hyperparameters changed
+    if(this->incremental) {
+        if(!this->isInverseValid()) {
+            this->computeInverse();
+            this->solve();
+        } else if(slid) {
+            this->solve();
+        }
+        return;
+    }
+
     // create kernel matrix
     yarp::sig::Matrix K(inputs.size() + 1, inputs.size() + 1);
     for(int r = 0; r < K.rows() - 1; r++) {
@@ -150,12 +378,21 @@ Prediction LSSVMLearner::predict(const yarp::sig::Vector& input) {
     }
 
     // compute kernel expansion
-    yarp::sig::Vector k(this->inputs.size());
-    for(size_t i = 0; i < k.size(); i++) {
-        k(i) = this->kernel->evaluate(this->inputs[i], input);
+    this->kernel->evaluate(this->inputs, input, this->kbuf);
+
+    // samples collected after the last training do not contribute
+    int n = std::min(this->alphas.rows(), (int) this->kbuf.size());
+
+    yarp::sig::Vector output(this->alphas.cols());
+    for(int c = 0; c < this->alphas.cols(); c++) {
+        output(c) = 0.0;
+        for(int i = 0; i < n; i++) {
+            output(c) += this->alphas(i, c) * this->kbuf(i);
+        }
+        output(c) += this->bias(c);
     }
 
-    return Prediction((this->alphas.transposed() * k) + this->bias);
+    return Prediction(output);
 }
 
 void LSSVMLearner::reset() {
@@ -164,6 +401,7 @@ void LSSVMLearner::reset() {
     this->alphas = yarp::sig::Matrix();
     this->LOO.clear();
     this->bias.clear();
+    this->Hinv = yarp::sig::Matrix();
 }
 
 LSSVMLearner* LSSVMLearner::clone() {
@@ -174,6 +412,8 @@ std::string LSSVMLearner::getInfo() {
     std::ostringstream buffer;
     buffer << this->IFixedSizeLearner::getInfo();
     buffer << "C: " << this->getC() << " | ";
+    buffer << "Incremental: " << (this->getIncremental() ? "yes" : "no") << " | ";
+    buffer << "Budget: " << this->getBudget() << " | ";
     buffer << "Collected Samples: " << this->inputs.size() << " | ";
     buffer << "Training Samples: " << this->alphas.rows() << " | ";
     buffer << "Kernel: " << this->kernel->getInfo() << std::endl;
@@ -186,11 +426,18 @@ std::string LSSVMLearner::getConfigHelp() {
     buffer << this->IFixedSizeLearner::getConfigHelp();
     //buffer << "  kernel idx|all cfg    Kernel configuration" << std::endl;
     buffer << "  c val                 Tradeoff parameter C" << std::endl;
+    buffer << "  incremental 0|1       Update the model at each fed sample" << std::endl;
+    buffer << "  budget n              Keep only the last n samples (0: unlimited)" << std::endl;
     buffer << this->kernel->getConfigHelp() << std::endl;
     return buffer.str();
 }
 
 void LSSVMLearner::writeBottle(yarp::os::Bottle& bot) {
+    // the sliding window settings go first, so that models saved without
+    // them can still be read
+    bot.addInt(this->incremental ? 1 : 0);
+    bot.addInt(this->budget);
+
     // write kernel gamma
     bot << this->kernel->getGamma() << this->getC() << this->bias
         << this->alphas;
@@ -242,6 +489,14 @@ void LSSVMLearner::readBottle(yarp::os::Bottle& bot) {
     bot >> this->alphas >> this->bias >> c >> gamma;
     this->setC(c);
     this->kernel->setGamma(gamma);
+
+    if(bot.size() > 1) {
+        this->budget = bot.pop().asInt();
+        this->incremental = (bot.pop().asInt() != 0);
+    } else {
+        this->budget = 0;
+        this->incremental = false;
+    }
 }
 
 void LSSVMLearner::setDomainSize(unsigned int size) {
@@ -265,6 +520,18 @@ bool LSSVMLearner::configure(yarp::os::Searchable& config) {
         }
     }
 
+    // format: set incremental 0|1
+    if(config.find("incremental").isInt()) {
+        this->setIncremental(config.find("incremental").asInt() != 0);
+        success = true;
+    }
+
+    // format: set budget n
+    if(config.find("budget").isInt() && config.find("budget").asInt() >= 0) {
+        this->setBudget(config.find("budget").asInt());
+        success = true;
+    }
+
     success |= this->kernel->configure(config);
 
     return success;
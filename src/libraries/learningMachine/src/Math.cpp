@@ -30,19 +30,13 @@ namespace iCub {
 namespace learningmachine {
 namespace math {
 
-void dchud(double* r, int ldr, int p, double* x, double* z, int ldz, int nz,
-           double* y, double* rho, double* c, double* s,
-           unsigned char rtrans, unsigned char ztrans) {
+/*
+ * Update of r in dchud, destroying the update vector work.
+ */
+static void dchudr(double* r, int p, double* work, double* c, double* s, unsigned char rtrans) {
     unsigned int i;
-    double* work = (double*) 0x0;
     double* tbuff = (double*) 0x0;
     unsigned int stp;
-    unsigned int stp2;
-    double scale, workscale, rhoscale;
-
-    // create working copy of x
-    work = (double*) malloc(p * sizeof(double));
-    cblas_dcopy(p, x, 1, work, 1);
 
     stp = (rtrans == 1) ? p : 1;
 
@@ -63,6 +57,23 @@ void dchud(double* r, int ldr, int p, double* x, double* z, int ldz, int nz,
             cblas_drot(p-i-1, tbuff+stp, stp, work+i+1, 1, c[i], s[i]);
         }
     }
+}
+
+void dchud(double* r, int ldr, int p, double* x, double* z, int ldz, int nz,
+           double* y, double* rho, double* c, double* s,
+           unsigned char rtrans, unsigned char ztrans) {
+    unsigned int i;
+    double* work = (double*) 0x0;
+    unsigned int stp;
+    unsigned int stp2;
+    double scale, workscale, rhoscale;
+
+    // create working copy of x
+    work = (double*) malloc(p * sizeof(double));
+    cblas_dcopy(p, x, 1, work, 1);
+
+    // update r and fill c and s on the go
+    dchudr(r, p, work, c, s, rtrans);
     free(work);
 
     // update z and rho if applicable
@@ -164,21 +175,49 @@ void cholupdate(yarp::sig::Matrix& R, const yarp::sig::Vector& x, bool rtrans) {
     gsl_linalg_cholesky_update(Rgsl, xgsl, cgsl, sgsl, NULL, NULL, NULL, (unsigned char) rtrans, 0);
 }
 
+void cholupdate(yarp::sig::Matrix& R, const yarp::sig::Matrix& X, yarp::sig::Vector& work,
+                yarp::sig::Vector& c, yarp::sig::Vector& s) {
+    int p = R.cols();
+    assert(R.rows() == R.cols());
+    assert(X.cols() == p);
+    assert((int)work.size() >= p && (int)c.size() >= p && (int)s.size() >= p);
+
+    for(int k = 0; k < X.rows(); k++) {
+        cblas_dcopy(p, X.data() + k * p, 1, work.data(), 1);
+        dchudr(R.data(), p, work.data(), c.data(), s.data(), 0);
+    }
+}
+
+void cholreflect(yarp::sig::Matrix& R) {
+    for(int i = 0; i < R.rows(); i++) {
+        for(int j = 0; j < i; j++) {
+            R(i, j) = R(j, i);
+        }
+    }
+}
+
 void cholsolve(const yarp::sig::Matrix& R, const yarp::sig::Matrix& B, yarp::sig::Matrix& X) {
     assert(B.rows() == X.rows());
     assert(B.cols() == X.cols());
     assert(R.rows() == R.cols());
     assert(R.cols() == B.cols());
 
-    yarp::sig::Vector x;
-    yarp::sig::Vector b;
+    int info;
+
+    yarp::gsl::GslMatrix RGslMat(R), BGslMat(B), XGslMat(X);
+
+    gsl_matrix* Rgsl = (gsl_matrix*) RGslMat.getGslMatrix();
+    gsl_matrix* Bgsl = (gsl_matrix*) BGslMat.getGslMatrix();
+    gsl_matrix* Xgsl = (gsl_matrix*) XGslMat.getGslMatrix();
+
+    // solve row by row on views of B and X
     for(int r = 0; r < B.rows(); r++) {
-        // we're forced to waste memory and computation here :(
-        b = B.getRow(r);
-        x = X.getRow(r);
-        cholsolve(R, b, x);
-        // copy back the solution
-        X.setRow(r, x);
+        gsl_vector_view b = gsl_matrix_row(Bgsl, r);
+        gsl_vector_view x = gsl_matrix_row(Xgsl, r);
+        info = gsl_linalg_cholesky_solve(Rgsl, &b.vector, &x.vector);
+        if(info) {
+            throw std::runtime_error(gsl_strerror(info));
+        }
     }
 }
 
@@ -37,6 +37,7 @@ namespace learningmachine {
 RLSLearner::RLSLearner(unsigned int dom, unsigned int cod, double lambda) {
     this->setName("RLS");
     this->sampleCount = 0;
+    this->refreshInterval = 0;
     // make sure to not use initialization list to constructor of base for
     // domain and codomain size, as it will not use overloaded mutators
     this->setDomainSize(dom);
@@ -46,8 +47,10 @@ RLSLearner::RLSLearner(unsigned int dom, unsigned int cod, double lambda) {
 }
 
 RLSLearner::RLSLearner(const RLSLearner& other)
-  : IFixedSizeLearner(other), sampleCount(other.sampleCount), R(other.R),
-    B(other.B), W(other.W), lambda(other.lambda) {
+  : IFixedSizeLearner(other), R(other.R), B(other.B), W(other.W),
+    sampleCount(other.sampleCount), lambda(other.lambda),
+    pendingCount(other.pendingCount), refreshInterval(other.refreshInterval),
+    x(other.x), work(other.work), c(other.c), s(other.s) {
 }
 
 RLSLearner::~RLSLearner() {
@@ -63,6 +66,13 @@ RLSLearner& RLSLearner::operator=(const RLSLearner& other) {
     this->B = other.B;
     this->W = other.W;
     this->lambda = other.lambda;
+    this->pendingCount = other.pendingCount;
+    this->refreshInterval = other.refreshInterval;
+
+    this->x = other.x;
+    this->work = other.work;
+    this->c = other.c;
+    this->s = other.s;
 
     return *this;
 }
@@ -71,15 +81,63 @@ void RLSLearner::feedSample(const yarp::sig::Vector& input, const yarp::sig::Vec
     this->IFixedSizeLearner::feedSample(input, output);
 
     // update R
-    cholupdate(this->R, input);
+    for(int i = 0; i < this->x.cols(); i++) {
+        this->x(0, i) = input(i);
+    }
+    cholupdate(this->R, this->x, this->work, this->c, this->s);
 
     // update B
-    this->B = this->B + outerprod(output, input);
+    for(int r = 0; r < this->B.rows(); r++) {
+        for(int i = 0; i < this->B.cols(); i++) {
+            this->B(r, i) += output(r) * input(i);
+        }
+    }
+
+    this->samplesFed(1);
+}
+
+void RLSLearner::feedSamples(const yarp::sig::Matrix& inputs, const yarp::sig::Matrix& outputs) {
+    if(inputs.rows() != outputs.rows()) {
+        throw std::runtime_error("Number of input and output samples differ");
+    }
+    if(inputs.cols() != (int) this->getDomainSize()) {
+        throw std::runtime_error("Input sample has invalid dimensionality");
+    }
+    if(outputs.cols() != (int) this->getCoDomainSize()) {
+        throw std::runtime_error("Output sample has invalid dimensionality");
+    }
+
+    // update R
+    cholupdate(this->R, inputs, this->work, this->c, this->s);
+
+    // update B
+    for(int k = 0; k < inputs.rows(); k++) {
+        for(int r = 0; r < this->B.rows(); r++) {
+            for(int i = 0; i < this->B.cols(); i++) {
+                this->B(r, i) += outputs(k, r) * inputs(k, i);
+            }
+        }
+    }
+
+    this->samplesFed(inputs.rows());
+}
+
+void RLSLearner::samplesFed(int n) {
+    this->sampleCount += n;
+    this->pendingCount += n;
 
-    // update W
-    cholsolve(this->R, this->B, this->W);
+    if(this->refreshInterval > 0 && this->pendingCount >= this->refreshInterval) {
+        this->updateWeights();
+    }
+}
 
-    this->sampleCount++;
+void RLSLearner::updateWeights() {
+    if(this->pendingCount > 0) {
+        // the updates only maintain the upper triangle of R
+        cholreflect(this->R);
+        cholsolve(this->R, this->B, this->W);
+        this->pendingCount = 0;
+    }
 }
 
 void RLSLearner::train() {
@@ -89,6 +147,8 @@ void RLSLearner::train() {
 Prediction RLSLearner::predict(const yarp::sig::Vector& input) {
     this->checkDomainSize(input);
 
+    this->updateWeights();
+
     yarp::sig::Vector output = (this->W * input);
 
     return Prediction(output);
@@ -96,15 +156,22 @@ Prediction RLSLearner::predict(const yarp::sig::Vector& input) {
 
 void RLSLearner::reset() {
     this->sampleCount = 0;
+    this->pendingCount = 0;
     this->R = eye(this->getDomainSize(), this->getDomainSize()) * sqrt(this->lambda);
     this->B = zeros(this->getCoDomainSize(), this->getDomainSize());
     this->W = zeros(this->getCoDomainSize(), this->getDomainSize());
+
+    this->x.resize(1, this->getDomainSize());
+    this->work.resize(this->getDomainSize());
+    this->c.resize(this->getDomainSize());
+    this->s.resize(this->getDomainSize());
 }
 
 std::string RLSLearner::getInfo() {
     std::ostringstream buffer;
     buffer << this->IFixedSizeLearner::getInfo();
     buffer << "Lambda: " << this->getLambda() << " | ";
+    buffer << "Refresh: " << this->getRefreshInterval() << " | ";
     buffer << "Sample Count: " << this->sampleCount << std::endl;
     //for(unsigned int i = 0; i < this->machines.size(); i++) {
     //    buffer << "  [" << (i + 1) << "] ";
@@ -118,10 +185,14 @@ std::string RLSLearner::getConfigHelp() {
     std::ostringstream buffer;
     buffer << this->IFixedSizeLearner::getConfigHelp();
     buffer << "  lambda val            Regularization parameter lambda" << std::endl;
+    buffer << "  refresh k             Recompute weights every k samples (0: on prediction)" << std::endl;
     return buffer.str();
 }
 
 void RLSLearner::writeBottle(yarp::os::Bottle& bot) {
+    this->updateWeights();
+    // the refresh interval goes first, so that models saved without it can still be read
+    bot.addInt(this->refreshInterval);
     bot << this->R << this->B << this->W << this->lambda << this->sampleCount;
     // make sure to call the superclass's method
     this->IFixedSizeLearner::writeBottle(bot);
@@ -131,6 +202,8 @@ void RLSLearner::readBottle(yarp::os::Bottle& bot) {
     // make sure to call the superclass's method
     this->IFixedSizeLearner::readBottle(bot);
     bot >> this->sampleCount >> this->lambda >> this->W >> this->B >> this->R;
+    this->setRefreshInterval((bot.size() > 0) ? bot.pop().asInt() : 0);
+    this->pendingCount = 0;
 }
 
 void RLSLearner::setDomainSize(unsigned int size) {
@@ -156,6 +229,18 @@ double RLSLearner::getLambda() {
     return this->lambda;
 }
 
+void RLSLearner::setRefreshInterval(int k) {
+    if(k >= 0) {
+        this->refreshInterval = k;
+    } else {
+        throw std::runtime_error("Refresh interval has to be non-negative");
+    }
+}
+
+int RLSLearner::getRefreshInterval() {
+    return this->refreshInterval;
+}
+
 
 bool RLSLearner::configure(yarp::os::Searchable& config) {
     bool success = this->IFixedSizeLearner::configure(config);
@@ -166,6 +251,12 @@ bool RLSLearner::configure(yarp::os::Searchable& config) {
         success = true;
     }
 
+    // format: set refresh val
+    if(config.find("refresh").isInt()) {
+        this->setRefreshInterval(config.find("refresh").asInt());
+        success = true;
+    }
+
     return success;
 }
 
@@ -20,6 +20,8 @@
 #include <sstream>
 #include <cmath>
 
+#include <gsl/gsl_blas.h>
+
 #include <yarp/math/Math.h>
 #include <yarp/math/Rand.h>
 
@@ -48,10 +50,37 @@ yarp::sig::Vector RandomFeature::transform(const yarp::sig::Vector& input) {
     yarp::sig::Vector output = this->IFixedSizeTransformer::transform(input);
 
     // python: x_f = numpy.cos(numpy.dot(self.W, x) + self.bias) / math.sqrt(self.nproj)
-    output = cosvec((this->W * input) + this->b) * (1. / std::sqrt((double) this->getCoDomainSize()));
+    cblas_dgemv(CblasRowMajor, CblasNoTrans, this->W.rows(), this->W.cols(), 1.0, this->W.data(),
+                this->W.cols(), input.data(), 1, 0.0, output.data(), 1);
+    this->expand(output.data());
     return output;
 }
 
+void RandomFeature::transformBatch(const yarp::sig::Matrix& inputs, yarp::sig::Matrix& outputs) {
+    this->prepareBatch(inputs, outputs);
+    if(inputs.rows() == 0) {
+        return;
+    }
+
+    // outputs = inputs * W'
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, inputs.rows(), this->W.rows(), inputs.cols(),
+                1.0, inputs.data(), inputs.cols(), this->W.data(), this->W.cols(),
+                0.0, outputs.data(), outputs.cols());
+
+    for(int r = 0; r < outputs.rows(); r++) {
+        this->expand(outputs.data() + r * outputs.cols());
+    }
+}
+
+void RandomFeature::expand(double* out) {
+    int n = this->getCoDomainSize();
+    double factor = 1. / std::sqrt((double) n);
+    const double* bp = this->b.data();
+    for(int i = 0; i < n; i++) {
+        out[i] = std::cos(out[i] + bp[i]) * factor;
+    }
+}
+
 void RandomFeature::setDomainSize(unsigned int size) {
     // call method in base class
     this->IFixedSizeTransformer::setDomainSize(size);
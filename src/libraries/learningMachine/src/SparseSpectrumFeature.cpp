@@ -22,6 +22,8 @@
 #include <algorithm>
 #include <cmath>
 
+#include <gsl/gsl_blas.h>
+
 #include <yarp/math/Math.h>
 #include <yarp/math/Rand.h>
 
@@ -52,14 +54,47 @@ SparseSpectrumFeature::SparseSpectrumFeature(unsigned int dom, unsigned int cod,
 yarp::sig::Vector SparseSpectrumFeature::transform(const yarp::sig::Vector& input) {
     yarp::sig::Vector output = this->IFixedSizeTransformer::transform(input);
 
-    yarp::sig::Vector inputW = (this->W * input);
+    // project into the first half of the output, then expand in place
+    int nproj = this->getCoDomainSize() >> 1;
+    cblas_dgemv(CblasRowMajor, CblasNoTrans, nproj, this->W.cols(), 1.0, this->W.data(),
+                this->W.cols(), input.data(), 1, 0.0, output.data(), 1);
+    this->expand(output.data(), nproj);
+    // an odd codomain leaves one column without a projection
+    if(this->getCoDomainSize() & 0x1) {
+        output(this->getCoDomainSize() - 1) = 0.0;
+    }
+    return output;
+}
+
+void SparseSpectrumFeature::transformBatch(const yarp::sig::Matrix& inputs, yarp::sig::Matrix& outputs) {
+    this->prepareBatch(inputs, outputs);
+    if(inputs.rows() == 0) {
+        return;
+    }
+
+    // outputs(:, 0:nproj-1) = inputs * W'
     int nproj = this->getCoDomainSize() >> 1;
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, inputs.rows(), nproj, inputs.cols(),
+                1.0, inputs.data(), inputs.cols(), this->W.data(), this->W.cols(),
+                0.0, outputs.data(), outputs.cols());
+
+    for(int r = 0; r < outputs.rows(); r++) {
+        this->expand(outputs.data() + r * outputs.cols(), nproj);
+        // same as transform() for the column without a projection
+        if(outputs.cols() & 0x1) {
+            outputs(r, outputs.cols() - 1) = 0.0;
+        }
+    }
+}
+
+void SparseSpectrumFeature::expand(double* out, int nproj) {
     double factor = this->sigma / sqrt((double)nproj);
     for(int i = 0; i < nproj; i++) {
-        output(i)       = cos(inputW(i)) * factor;
-        output(i+nproj) = sin(inputW(i)) * factor;
+        out[i+nproj] = sin(out[i]) * factor;
+    }
+    for(int i = 0; i < nproj; i++) {
+        out[i] = cos(out[i]) * factor;
     }
-    return output;
 }
 
 void SparseSpectrumFeature::setDomainSize(unsigned int size) {
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Istituto Italiano di Tecnologia - iCub Facility
+ * CopyPolicy: Released under the terms of the GNU GPL v2.0.
+ */
+
+// DatasetRecorder serialization: the output format is stored with the
+// filename and the precision, and recorders saved before the binary format
+// existed still load as text recorders.
+
+#include <iostream>
+#include <string>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/Property.h>
+
+#include "iCub/learningMachine/DatasetRecorder.h"
+
+using namespace yarp::os;
+using namespace iCub::learningmachine;
+
+int main() {
+    int failures = 0;
+
+    struct {
+        const char* name;
+        const char* config;
+        const char* serialized;
+    } cases[] = {
+        { "text", "(filename \"text.dat\") (precision 5)", "\"text.dat\" 5 0" },
+        { "binary", "(filename \"bin.dat\") (precision 12) (format binary)", "\"bin.dat\" 12 1" }
+    };
+
+    for(unsigned int i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        DatasetRecorder recorder;
+        Property config(cases[i].config);
+        recorder.configure(config);
+        std::string expected = Bottle(cases[i].serialized).toString().c_str();
+
+        if(recorder.toString() != expected) {
+            std::cerr << "FAILED " << cases[i].name << ": serialized as '" << recorder.toString()
+                      << "', expected '" << expected << "'" << std::endl;
+            failures++;
+        }
+
+        DatasetRecorder restored;
+        restored.fromString(recorder.toString());
+        if(restored.toString() != expected) {
+            std::cerr << "FAILED " << cases[i].name << ": restored as '" << restored.toString()
+                      << "'" << std::endl;
+            failures++;
+        }
+    }
+
+    // a recorder saved with filename and precision only
+    DatasetRecorder legacy;
+    legacy.fromString("\"legacy.dat\" 7");
+    std::string expected = Bottle("\"legacy.dat\" 7 0").toString().c_str();
+    if(legacy.toString() != expected) {
+        std::cerr << "FAILED legacy: restored as '" << legacy.toString() << "'" << std::endl;
+        failures++;
+    }
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -308,6 +308,25 @@ public:
     */
     virtual bool write(yarp::os::ConnectionWriter& connection);
 
+    /**
+    * Number of bytes of the flat binary representation of this dynContact.
+    */
+    virtual size_t flatSize() const;
+    /**
+    * Write this dynContact in flat binary form, that is 3 int32 (contactId, bodyPart, linkNumber)
+    * followed by 9 double (CoP, force, moment), in native byte order.
+    * @param buf buffer of at least flatSize() bytes
+    * @return pointer to the first byte after the written data
+    */
+    virtual char* writeFlat(char *buf) const;
+    /**
+    * Read this dynContact from its flat binary form, reusing the memory of this object.
+    * @param buf pointer to the first byte to read
+    * @param end pointer to the first byte after the end of the buffer
+    * @return pointer to the first byte after the read data, or 0 if the buffer is too short
+    */
+    virtual const char* readFlat(const char *buf, const char *end);
+
     
     /**
      * Convert this contact into a string. Useful to print some information.
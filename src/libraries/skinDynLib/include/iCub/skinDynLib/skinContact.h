@@ -255,6 +255,27 @@ public:
     */
     virtual bool write(yarp::os::ConnectionWriter& connection);
 
+    /**
+    * Number of bytes of the flat binary representation of this skinContact.
+    */
+    virtual size_t flatSize() const;
+    /**
+    * Write this skinContact in flat binary form, that is the flat form of the dynContact
+    * followed by skinPart and the number of active taxels (int32), the geometric center,
+    * the normal direction and the pressure (7 double) and the active taxel ids (uint32).
+    * @param buf buffer of at least flatSize() bytes
+    * @return pointer to the first byte after the written data
+    */
+    virtual char* writeFlat(char *buf) const;
+    /**
+    * Read this skinContact from its flat binary form. The taxel list keeps its capacity,
+    * so reading contacts of similar size does not allocate memory.
+    * @param buf pointer to the first byte to read
+    * @param end pointer to the first byte after the end of the buffer
+    * @return pointer to the first byte after the read data, or 0 if the buffer is not valid
+    */
+    virtual const char* readFlat(const char *buf, const char *end);
+
     /**
     * Convert this skinContact to a vector. The size of the vector is 21 plus
     * the number of active taxels. The vector contains this data, in this order:
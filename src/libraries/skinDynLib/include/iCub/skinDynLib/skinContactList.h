@@ -44,7 +44,15 @@ namespace skinDynLib
 class skinContactList  : public std::vector<skinContact>, public yarp::os::Portable
 {
 protected:
-    
+    // if true the list is written with the flat binary encoding
+    bool binaryEncoding;
+    // buffer used to encode and decode the flat binary encoding
+    std::vector<char> flatBuffer;
+
+    // read/write the list with the flat binary encoding
+    bool readFlat(yarp::os::ConnectionReader& connection);
+    bool writeFlat(yarp::os::ConnectionWriter& connection);
+
 public:
     //~~~~~~~~~~~~~~~~~~~~~~
     //   CONSTRUCTORS
@@ -85,6 +93,17 @@ public:
     */
     virtual bool write(yarp::os::ConnectionWriter& connection);
 
+    /**
+    * Select the encoding used by write(). The legacy encoding is a list with one sub-list per contact.
+    * The binary encoding is a list containing a single blob, which starts with a version vocab and
+    * the number of contacts, followed by the flat binary representation of each contact.
+    * The binary encoding is much faster to write and read, but the remote side must use a version of
+    * this library that supports it. read() accepts both encodings.
+    * @param binary true to write the binary encoding, false to write the legacy encoding (default)
+    */
+    void setBinaryEncoding(bool binary){ binaryEncoding = binary; }
+    bool getBinaryEncoding() const{ return binaryEncoding; }
+
     /**
      * Convert this skinContactList to a dynContactList casting all its elements
      * to dynContact.
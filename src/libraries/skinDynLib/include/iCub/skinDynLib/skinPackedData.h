@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Istituto Italiano di Tecnologia - iCub Facility
+ * CopyPolicy: Released under the terms of the GNU GPL v2.0.
+ *
+ */
+
+#ifndef __SKINPACKEDDATA_H__
+#define __SKINPACKEDDATA_H__
+
+#include <vector>
+#include <string>
+#include <yarp/os/Portable.h>
+#include <yarp/sig/Vector.h>
+
+namespace iCub
+{
+namespace skinDynLib
+{
+
+/**
+* @ingroup skinDynLib
+*
+* Class representing the output of all the taxels of a skin part, with one byte per taxel
+* (taxel values range from 0 to 255).
+*
+* On the wire the data are a list of 3 elements: an encoding vocab, the number of taxels and a blob.
+* With the dense encoding the blob contains one byte per taxel; with the sparse encoding it contains
+* 3 bytes (16 bit taxel id, little endian, and value) for each taxel whose value is not zero.
+* The sparse encoding is chosen automatically when it is shorter, if enabled.
+*
+* The read method also accepts a plain yarp::sig::Vector of doubles, so a port of this type can be
+* connected to producers that still send vectors.
+*/
+class skinPackedData : public yarp::os::Portable
+{
+protected:
+    // value of each taxel
+    std::vector<unsigned char> values;
+    // if true the sparse encoding is used when it is shorter than the dense one
+    bool sparse;
+    // buffer for the sparse encoding
+    std::vector<unsigned char> sparseBuffer;
+
+public:
+    //~~~~~~~~~~~~~~~~~~~~~~
+    //   CONSTRUCTORS
+    //~~~~~~~~~~~~~~~~~~~~~~
+    skinPackedData();
+    skinPackedData(const size_t &n);
+
+    //~~~~~~~~~~~~~~~~~~~~~~
+    //   GET methods
+    //~~~~~~~~~~~~~~~~~~~~~~
+    size_t size() const{                    return values.size(); }
+    unsigned char* data(){                  return values.empty() ? 0 : &values[0]; }
+    const unsigned char* data() const{      return values.empty() ? 0 : &values[0]; }
+    unsigned char& operator[](size_t i){    return values[i]; }
+    unsigned char operator[](size_t i) const{ return values[i]; }
+    bool getSparse() const{                 return sparse; }
+
+    /**
+    * Copy the taxel values into a vector of doubles.
+    */
+    void toVector(yarp::sig::Vector &v) const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~
+    //   SET methods
+    //~~~~~~~~~~~~~~~~~~~~~~
+    void resize(const size_t &n){           values.resize(n, 0); }
+    void setSparse(bool _sparse){           sparse = _sparse; }
+
+    /**
+    * Set the taxel values from a vector of doubles, rounding them and
+    * saturating them in [0, 255].
+    */
+    void fromVector(const yarp::sig::Vector &v);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~
+    //   SERIALIZATION methods
+    //~~~~~~~~~~~~~~~~~~~~~~~~~
+    /*
+    * Read the taxel values from a connection, either in the packed format or as a vector of doubles.
+    * return true iff the data were read correctly
+    */
+    virtual bool read(yarp::os::ConnectionReader& connection);
+
+    /**
+    * Write the taxel values to a connection in the packed format.
+    * return true iff the data were written correctly
+    */
+    virtual bool write(yarp::os::ConnectionWriter& connection);
+
+    /**
+     * Useful to print some information.
+     */
+    virtual std::string toString() const;
+};
+
+}
+
+}
+#endif
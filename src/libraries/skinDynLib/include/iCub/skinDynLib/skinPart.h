@@ -170,6 +170,36 @@ class skinPart : public skinPartBase
     **/
     std::map<int, std::list<unsigned int> > repr2TaxelList;
 
+    /**
+    * Contiguous copy of the taxel positions w.r.t. the limb, stored as packed (x,y,z) floats.
+    * Element 3*i of this table refers to taxels[i]. It is rebuilt by updateTaxelTable().
+    **/
+    std::vector<float> taxelPositions;
+
+    /**
+    * Contiguous copy of the taxel normals w.r.t. the limb, stored as packed (x,y,z) floats.
+    **/
+    std::vector<float> taxelNormals;
+
+    /**
+    * Taxel positions w.r.t. the root FoR, stored as packed (x,y,z) floats.
+    * They are computed by projectTaxels().
+    **/
+    std::vector<float> taxelWRFPositions;
+
+    /**
+    * Taxel normals w.r.t. the root FoR, stored as packed (x,y,z) floats.
+    * They are computed by projectTaxels().
+    **/
+    std::vector<float> taxelWRFNormals;
+
+    /**
+    * Taxel (u,v) projections in the image plane of one of the eyes, stored as packed floats.
+    * They are computed by projectTaxels() when the camera is specified; taxels lying
+    * on or behind the image plane are marked as invalid with NaN coordinates.
+    **/
+    std::vector<float> taxelPx;
+
   protected:
     /**
      * Populates the skinPart by reading from a file - old convention.
@@ -235,6 +265,34 @@ class skinPart : public skinPartBase
      */
     int getTaxelsSize();
 
+    /**
+     * Rebuilds the contiguous taxel table (taxelPositions and taxelNormals) from the taxels vector.
+     * It is called whenever the taxels are loaded or copied; call it again if the taxels
+     * are modified directly.
+     */
+    void updateTaxelTable();
+
+    /**
+     * Projects all the taxels of the skinPart into the root FoR in a single pass over
+     * the taxel table. The results are stored in taxelWRFPositions and taxelWRFNormals.
+     * @param _H is the 4x4 roto-translation from the limb to the root FoR
+     *           (e.g. as returned by iKinChain::getH() for the link the skinPart is attached to)
+     * @return true/false in case of success/failure
+     */
+    bool projectTaxels(const yarp::sig::Matrix &_H);
+
+    /**
+     * Projects all the taxels of the skinPart into the root FoR and into the image plane
+     * of one of the eyes in a single pass over the taxel table. The results are stored
+     * in taxelWRFPositions, taxelWRFNormals and taxelPx.
+     * @param _H    is the 4x4 roto-translation from the limb to the root FoR
+     * @param _eyeH is the 4x4 roto-translation from the eye to the root FoR
+     * @param _Prj  is the 3x4 projection matrix of the camera (intrinsic parameters)
+     * @return true/false in case of success/failure
+     */
+    bool projectTaxels(const yarp::sig::Matrix &_H, const yarp::sig::Matrix &_eyeH,
+                       const yarp::sig::Matrix &_Prj);
+
     /**
      * Clears the vector of taxels properly and gracefully.
      * WARNING: it deletes the pointed objects as well!
@@ -9,6 +9,8 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <cstring>
+#include <cmath>
 #include "stdio.h"
 
 #include <yarp/math/Math.h>
@@ -258,6 +260,41 @@ bool dynContact::read(ConnectionReader& connection){
     return !connection.isError();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+size_t dynContact::flatSize() const{
+    return 3*sizeof(int) + 9*sizeof(double);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+char* dynContact::writeFlat(char *buf) const{
+    // the fields are copied with memcpy because buf may not be aligned
+    int ids[3] = { (int)contactId, (int)bodyPart, (int)linkNumber };
+    memcpy(buf, ids, sizeof(ids));                  buf += sizeof(ids);
+    memcpy(buf, CoP.data(), 3*sizeof(double));      buf += 3*sizeof(double);
+    memcpy(buf, F.data(), 3*sizeof(double));        buf += 3*sizeof(double);
+    memcpy(buf, Mu.data(), 3*sizeof(double));       buf += 3*sizeof(double);
+    return buf;
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+const char* dynContact::readFlat(const char *buf, const char *end){
+    if(end-buf < (ptrdiff_t)dynContact::flatSize())
+        return 0;
+    int ids[3];
+    memcpy(ids, buf, sizeof(ids));                  buf += sizeof(ids);
+    contactId   = ids[0];
+    bodyPart    = (BodyPart)ids[1];
+    linkNumber  = ids[2];
+    // the vectors are overwritten in place, without allocating memory
+    if(CoP.size()!=3)
+        CoP.resize(3);
+    memcpy(CoP.data(), buf, 3*sizeof(double));      buf += 3*sizeof(double);
+    memcpy(F.data(), buf, 3*sizeof(double));        buf += 3*sizeof(double);
+    memcpy(Mu.data(), buf, 3*sizeof(double));       buf += 3*sizeof(double);
+    // same as setForce(F), without the temporary vectors
+    Fmodule = sqrt(F[0]*F[0] + F[1]*F[1] + F[2]*F[2]);
+    if(Fmodule!=0.0)
+        for(int i=0;i<3;i++) Fdir[i] = F[i]/Fmodule;
+    return buf;
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 string dynContact::toString(int precision) const{
     stringstream res;
     res<< "Contact id: "<< contactId<< ", Body part: "<< BodyPart_s[bodyPart]<< ", link: "<< linkNumber<< ", CoP: "<< 
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <cstring>
 #include <yarp/math/Math.h>
 #include "iCub/skinDynLib/skinContact.h"
 
@@ -214,6 +215,48 @@ bool skinContact::read(ConnectionReader& connection){
     return !connection.isError();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+size_t skinContact::flatSize() const{
+    return dynContact::flatSize() + 2*sizeof(int) + 7*sizeof(double) + activeTaxels*sizeof(unsigned int);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+char* skinContact::writeFlat(char *buf) const{
+    buf = dynContact::writeFlat(buf);
+    int ids[2] = { (int)skinPart, (int)activeTaxels };
+    memcpy(buf, ids, sizeof(ids));                      buf += sizeof(ids);
+    memcpy(buf, geoCenter.data(), 3*sizeof(double));    buf += 3*sizeof(double);
+    memcpy(buf, normalDir.data(), 3*sizeof(double));    buf += 3*sizeof(double);
+    memcpy(buf, &pressure, sizeof(double));             buf += sizeof(double);
+    if(activeTaxels>0)
+        memcpy(buf, &taxelList[0], activeTaxels*sizeof(unsigned int));
+    buf += activeTaxels*sizeof(unsigned int);
+    return buf;
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+const char* skinContact::readFlat(const char *buf, const char *end){
+    buf = dynContact::readFlat(buf, end);
+    if(buf==0 || end-buf < (ptrdiff_t)(2*sizeof(int) + 7*sizeof(double)))
+        return 0;
+    int ids[2];
+    memcpy(ids, buf, sizeof(ids));                      buf += sizeof(ids);
+    if(ids[1]<0 || (size_t)(end-buf-7*sizeof(double))/sizeof(unsigned int) < (size_t)ids[1])
+        return 0;
+    skinPart        = (SkinPart)ids[0];
+    activeTaxels    = ids[1];
+    if(geoCenter.size()!=3)
+        geoCenter.resize(3);
+    if(normalDir.size()!=3)
+        normalDir.resize(3);
+    memcpy(geoCenter.data(), buf, 3*sizeof(double));    buf += 3*sizeof(double);
+    memcpy(normalDir.data(), buf, 3*sizeof(double));    buf += 3*sizeof(double);
+    memcpy(&pressure, buf, sizeof(double));             buf += sizeof(double);
+    // resize does not release memory, so the taxel list is reallocated only when it grows
+    taxelList.resize(activeTaxels);
+    if(activeTaxels>0)
+        memcpy(&taxelList[0], buf, activeTaxels*sizeof(unsigned int));
+    buf += activeTaxels*sizeof(unsigned int);
+    return buf;
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 Vector skinContact::toVector() const{
     Vector v(activeTaxels+21);
     unsigned int index = 0;
@@ -9,6 +9,8 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <cstring>
+#include <yarp/os/Vocab.h>
 
 #include "iCub/skinDynLib/skinContactList.h"
 #include <iCub/ctrl/math.h>
@@ -17,15 +19,18 @@ using namespace std;
 using namespace yarp::os;
 using namespace iCub::skinDynLib;
 
+// version tag of the flat binary encoding
+#define SKIN_CONTACT_LIST_FLAT  VOCAB4('s','c','l','1')
+
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //   CONSTRUCTORS
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 skinContactList::skinContactList()
-:vector<skinContact>(){}
+:vector<skinContact>(), binaryEncoding(false){}
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 skinContactList::skinContactList(const size_type &n, const skinContact& value)
-:vector<skinContact>(n, value){}
+:vector<skinContact>(n, value), binaryEncoding(false){}
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 skinContactList skinContactList::filterBodyPart(const BodyPart &bp)
 {
@@ -58,7 +63,10 @@ bool skinContactList::read(ConnectionReader& connection)
 {
     // A skinContactList is represented as a list of list
     // where each list is a skinContact
-    if(connection.expectInt()!=BOTTLE_TAG_LIST)
+    int tag = connection.expectInt();
+    if(tag==BOTTLE_TAG_LIST+BOTTLE_TAG_BLOB)
+        return readFlat(connection);
+    if(tag!=BOTTLE_TAG_LIST)
         return false;
 
     int listLength = connection.expectInt();
@@ -78,6 +86,9 @@ bool skinContactList::write(ConnectionWriter& connection)
 {
     // A skinContactList is represented as a list of list
     // where each list is a skinContact
+    if(binaryEncoding)
+        return writeFlat(connection);
+
     connection.appendInt(BOTTLE_TAG_LIST);
     connection.appendInt(size());
 
@@ -88,6 +99,58 @@ bool skinContactList::write(ConnectionWriter& connection)
     return !connection.isError();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool skinContactList::readFlat(ConnectionReader& connection)
+{
+    // the BOTTLE_TAG_LIST+BOTTLE_TAG_BLOB tag has already been read
+    if(connection.expectInt()!=1)
+        return false;
+    int len = connection.expectInt();
+    if(len<(int)(2*sizeof(int)))
+        return false;
+    // the buffer is reused across reads, so it is reallocated only when it grows
+    flatBuffer.resize(len);
+    if(!connection.expectBlock(&flatBuffer[0], len))
+        return false;
+
+    const char *buf = &flatBuffer[0];
+    const char *bufEnd = buf + len;
+    int header[2];
+    memcpy(header, buf, sizeof(header));
+    buf += sizeof(header);
+    if(header[0]!=SKIN_CONTACT_LIST_FLAT || header[1]<0)
+        return false;
+    // the contacts already in the list are overwritten in place
+    if((size_type)header[1]!=size())
+        resize(header[1]);
+    for(iterator it=begin(); it!=end(); it++)
+        if((buf = it->readFlat(buf, bufEnd))==0)
+            return false;
+
+    return !connection.isError();
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool skinContactList::writeFlat(ConnectionWriter& connection)
+{
+    size_t len = 2*sizeof(int);
+    for(const_iterator it=begin(); it!=end(); it++)
+        len += it->flatSize();
+    flatBuffer.resize(len);
+
+    int header[2] = { SKIN_CONTACT_LIST_FLAT, (int)size() };
+    memcpy(&flatBuffer[0], header, sizeof(header));
+    char *buf = &flatBuffer[0] + sizeof(header);
+    for(const_iterator it=begin(); it!=end(); it++)
+        buf = it->writeFlat(buf);
+
+    // a list containing a single blob, which is sent without copying it
+    connection.appendInt(BOTTLE_TAG_LIST+BOTTLE_TAG_BLOB);
+    connection.appendInt(1);
+    connection.appendInt((int)len);
+    connection.appendExternalBlock(&flatBuffer[0], len);
+
+    return !connection.isError();
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 dynContactList skinContactList::toDynContactList() const
 {
     dynContactList res(this->size());
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 Istituto Italiano di Tecnologia - iCub Facility
+ * CopyPolicy: Released under the terms of the GNU GPL v2.0.
+ *
+ */
+
+#include <sstream>
+#include <yarp/os/Bottle.h>
+#include <yarp/os/Vocab.h>
+#include <yarp/os/ConnectionReader.h>
+#include <yarp/os/ConnectionWriter.h>
+
+#include "iCub/skinDynLib/skinPackedData.h"
+
+using namespace std;
+using namespace yarp::os;
+using namespace yarp::sig;
+using namespace iCub::skinDynLib;
+
+#define SKIN_PACKED_DENSE   VOCAB4('s','k','p','d')
+#define SKIN_PACKED_SPARSE  VOCAB4('s','k','p','s')
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//   CONSTRUCTORS
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+skinPackedData::skinPackedData()
+:sparse(false){}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+skinPackedData::skinPackedData(const size_t &n)
+:values(n, 0), sparse(false){}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void skinPackedData::toVector(Vector &v) const
+{
+    v.resize(values.size());
+    for(size_t i=0; i<values.size(); i++)
+        v[i] = values[i];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void skinPackedData::fromVector(const Vector &v)
+{
+    values.resize(v.size());
+    double d;
+    for(size_t i=0; i<v.size(); i++)
+    {
+        d = v[i]+0.5;
+        values[i] = d<=0.0 ? 0 : (d>=255.0 ? 255 : (unsigned char)d);
+    }
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//   SERIALIZATION methods
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool skinPackedData::write(ConnectionWriter& connection)
+{
+    // represent the data as a list of 3 elements that are:
+    // - a vocab, i.e. the encoding (dense or sparse)
+    // - an int, i.e. the number of taxels
+    // - a blob, i.e. the taxel values
+    size_t active = 0;
+    if(sparse)
+        for(size_t i=0; i<values.size(); i++)
+            if(values[i]!=0)
+                active++;
+    // taxel ids are encoded with 16 bits
+    bool useSparse = sparse && values.size()<=65536 && 3*active<values.size();
+
+    connection.appendInt(BOTTLE_TAG_LIST);
+    connection.appendInt(3);
+    connection.appendInt(BOTTLE_TAG_VOCAB);
+    connection.appendInt(useSparse ? SKIN_PACKED_SPARSE : SKIN_PACKED_DENSE);
+    connection.appendInt(BOTTLE_TAG_INT);
+    connection.appendInt((int)values.size());
+    connection.appendInt(BOTTLE_TAG_BLOB);
+    if(useSparse)
+    {
+        sparseBuffer.resize(3*active);
+        size_t k = 0;
+        for(size_t i=0; i<values.size(); i++)
+        {
+            if(values[i]!=0)
+            {
+                sparseBuffer[k++] = (unsigned char)(i & 0xFF);
+                sparseBuffer[k++] = (unsigned char)(i >> 8);
+                sparseBuffer[k++] = values[i];
+            }
+        }
+        connection.appendInt((int)sparseBuffer.size());
+        if(!sparseBuffer.empty())
+            connection.appendExternalBlock((const char*)&sparseBuffer[0], sparseBuffer.size());
+    }
+    else
+    {
+        // the values are sent without copying them
+        connection.appendInt((int)values.size());
+        if(!values.empty())
+            connection.appendExternalBlock((const char*)&values[0], values.size());
+    }
+
+    // if someone is foolish enough to connect in text mode,
+    // let them see something readable.
+    connection.convertTextMode();
+
+    return !connection.isError();
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool skinPackedData::read(ConnectionReader& connection)
+{
+    // auto-convert text mode interaction
+    connection.convertTextMode();
+
+    int tag = connection.expectInt();
+
+    // producers that have not been updated send a vector of doubles
+    if(tag == BOTTLE_TAG_LIST+BOTTLE_TAG_DOUBLE)
+    {
+        int n = connection.expectInt();
+        if(n<0)
+            return false;
+        values.resize(n);
+        double d;
+        for(int i=0; i<n; i++)
+        {
+            d = connection.expectDouble()+0.5;
+            values[i] = d<=0.0 ? 0 : (d>=255.0 ? 255 : (unsigned char)d);
+        }
+        return !connection.isError();
+    }
+
+    if(tag!=BOTTLE_TAG_LIST || connection.expectInt()!=3)
+        return false;
+    if(connection.expectInt()!=BOTTLE_TAG_VOCAB)
+        return false;
+    int encoding = connection.expectInt();
+    if(connection.expectInt()!=BOTTLE_TAG_INT)
+        return false;
+    int n = connection.expectInt();
+    if(n<0 || connection.expectInt()!=BOTTLE_TAG_BLOB)
+        return false;
+    int len = connection.expectInt();
+    if(len<0)
+        return false;
+
+    values.resize(n);
+    if(encoding == SKIN_PACKED_DENSE)
+    {
+        // the values are read directly into the taxel array
+        if(len!=n)
+            return false;
+        if(n>0 && !connection.expectBlock((char*)&values[0], n))
+            return false;
+    }
+    else if(encoding == SKIN_PACKED_SPARSE)
+    {
+        if(len%3!=0)
+            return false;
+        sparseBuffer.resize(len);
+        if(len>0 && !connection.expectBlock((char*)&sparseBuffer[0], len))
+            return false;
+        values.assign(n, 0);
+        size_t id;
+        for(int k=0; k<len; k+=3)
+        {
+            id = sparseBuffer[k] | (sparseBuffer[k+1]<<8);
+            if(id>=values.size())
+                return false;
+            values[id] = sparseBuffer[k+2];
+        }
+    }
+    else
+        return false;
+
+    return !connection.isError();
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+string skinPackedData::toString() const
+{
+    stringstream res;
+    for(size_t i=0; i<values.size(); i++)
+        res<< (int)values[i]<< " ";
+    return res.str();
+}
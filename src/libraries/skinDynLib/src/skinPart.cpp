@@ -1,3 +1,4 @@
+#include <limits>
 #include "iCub/skinDynLib/skinPart.h"
 
 using namespace yarp::math;
@@ -111,6 +112,11 @@ using namespace iCub::skinDynLib;
         {
             taxels.push_back(new Taxel(*(*it)));
         }
+        taxelPositions    = _sp.taxelPositions;
+        taxelNormals      = _sp.taxelNormals;
+        taxelWRFPositions = _sp.taxelWRFPositions;
+        taxelWRFNormals   = _sp.taxelWRFNormals;
+        taxelPx           = _sp.taxelPx;
 
         return *this;
     }
@@ -208,6 +214,7 @@ using namespace iCub::skinDynLib;
                 taxels.push_back(new Taxel(taxelPos,taxelNrm,i-1));
             }
         }
+        updateTaxelTable();
 
         // Let's read the mapping of the taxels onto the center of their triangle
         // even if the spatial_sampling variable is "taxel"
@@ -280,6 +287,7 @@ using namespace iCub::skinDynLib;
             else
                 setSize(getSize()+1);
         }
+        updateTaxelTable();
 
         return mapTaxelsOntoThemselves() && initRepresentativeTaxels();
     }
@@ -334,6 +342,117 @@ using namespace iCub::skinDynLib;
          return taxels.size();
     }
 
+    void skinPart::updateTaxelTable()
+    {
+        yarp::os::RecursiveLockGuard rlg(recursive_mutex);
+        size_t n = taxels.size();
+        taxelPositions.resize(3*n);
+        taxelNormals.resize(3*n);
+        taxelWRFPositions.resize(3*n);
+        taxelWRFNormals.resize(3*n);
+        taxelPx.resize(2*n);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            yarp::sig::Vector pos = taxels[i]->getPosition();
+            yarp::sig::Vector nrm = taxels[i]->getNormal();
+            for (size_t j = 0; j < 3; j++)
+            {
+                taxelPositions[3*i+j] = float(pos[j]);
+                taxelNormals[3*i+j]   = float(nrm[j]);
+            }
+        }
+    }
+
+    bool skinPart::projectTaxels(const yarp::sig::Matrix &_H)
+    {
+        yarp::os::RecursiveLockGuard rlg(recursive_mutex);
+        if (_H.rows()!=4 || _H.cols()!=4)
+        {
+            yError("[skinPart::projectTaxels] The roto-translation matrix should be 4x4!");
+            return false;
+        }
+
+        size_t n = taxelPositions.size()/3;
+        taxelWRFPositions.resize(3*n);
+        taxelWRFNormals.resize(3*n);
+        if (n==0)
+        {
+            return true;
+        }
+
+        // The transform is loaded once, then the whole table is processed
+        // in a loop without branches nor function calls (so that it vectorizes)
+        const float r00=float(_H(0,0)), r01=float(_H(0,1)), r02=float(_H(0,2)), t0=float(_H(0,3));
+        const float r10=float(_H(1,0)), r11=float(_H(1,1)), r12=float(_H(1,2)), t1=float(_H(1,3));
+        const float r20=float(_H(2,0)), r21=float(_H(2,1)), r22=float(_H(2,2)), t2=float(_H(2,3));
+
+        const float *p = &taxelPositions[0];
+        const float *nl = &taxelNormals[0];
+        float       *w = &taxelWRFPositions[0];
+        float       *nw = &taxelWRFNormals[0];
+        for (size_t i = 0; i < n; i++)
+        {
+            const float x=p[3*i], y=p[3*i+1], z=p[3*i+2];
+            w[3*i]   = r00*x + r01*y + r02*z + t0;
+            w[3*i+1] = r10*x + r11*y + r12*z + t1;
+            w[3*i+2] = r20*x + r21*y + r22*z + t2;
+
+            // normals are only rotated
+            const float nx=nl[3*i], ny=nl[3*i+1], nz=nl[3*i+2];
+            nw[3*i]   = r00*nx + r01*ny + r02*nz;
+            nw[3*i+1] = r10*nx + r11*ny + r12*nz;
+            nw[3*i+2] = r20*nx + r21*ny + r22*nz;
+        }
+
+        return true;
+    }
+
+    bool skinPart::projectTaxels(const yarp::sig::Matrix &_H, const yarp::sig::Matrix &_eyeH,
+                                 const yarp::sig::Matrix &_Prj)
+    {
+        yarp::os::RecursiveLockGuard rlg(recursive_mutex);
+        if (_eyeH.rows()!=4 || _eyeH.cols()!=4 || _Prj.rows()!=3 || _Prj.cols()!=4)
+        {
+            yError("[skinPart::projectTaxels] The eye matrix should be 4x4 and the projection matrix 3x4!");
+            return false;
+        }
+
+        if (!projectTaxels(_H))
+        {
+            return false;
+        }
+
+        size_t n = taxelWRFPositions.size()/3;
+        taxelPx.resize(2*n);
+        if (n==0)
+        {
+            return true;
+        }
+
+        // Root FoR -> image plane, computed once for all the taxels
+        yarp::sig::Matrix M = _Prj*SE3inv(_eyeH);
+        const float m00=float(M(0,0)), m01=float(M(0,1)), m02=float(M(0,2)), m03=float(M(0,3));
+        const float m10=float(M(1,0)), m11=float(M(1,1)), m12=float(M(1,2)), m13=float(M(1,3));
+        const float m20=float(M(2,0)), m21=float(M(2,1)), m22=float(M(2,2)), m23=float(M(2,3));
+
+        // taxels on or behind the image plane have no valid projection: the select
+        // below marks them with NaN and keeps the loop free of branches
+        const float nan=std::numeric_limits<float>::quiet_NaN();
+        const float *w  = &taxelWRFPositions[0];
+        float       *px = &taxelPx[0];
+        for (size_t i = 0; i < n; i++)
+        {
+            const float x=w[3*i], y=w[3*i+1], z=w[3*i+2];
+            const float d=m20*x + m21*y + m22*z + m23;
+            const float s=(d>0.0f) ? 1.0f/d : nan;
+            px[2*i]   = (m00*x + m01*y + m02*z + m03)*s;
+            px[2*i+1] = (m10*x + m11*y + m12*z + m13)*s;
+        }
+
+        return true;
+    }
+
     void skinPart::clearTaxels()
     {
         yarp::os::RecursiveLockGuard rlg(recursive_mutex);
@@ -346,6 +465,7 @@ using namespace iCub::skinDynLib;
             taxels.pop_back();
         }
         taxels.clear();
+        updateTaxelTable();
     }
 
     void skinPart::print(int verbosity)
@@ -19,6 +19,9 @@
 #ifndef LM_PREDICTMODULE__
 #define LM_PREDICTMODULE__
 
+#include <yarp/os/Mutex.h>
+#include <yarp/os/LockGuard.h>
+
 #include "iCub/learningMachine/IMachineLearnerModule.h"
 #include "iCub/learningMachine/MachinePortable.h"
 
@@ -41,13 +44,21 @@ protected:
      */
     MachinePortable& machinePortable;
 
+    /**
+     * Mutex guarding the machine against concurrent access from the port
+     * threads of the module.
+     */
+    yarp::os::Mutex& machineMutex;
+
 public:
     /**
      * Constructor.
      *
      * @param mp a pointer to a machine portable.
+     * @param mutex a reference to the mutex guarding the machine.
      */
-    IMachineProcessor(MachinePortable& mp) : machinePortable(mp) { }
+    IMachineProcessor(MachinePortable& mp, yarp::os::Mutex& mutex)
+      : machinePortable(mp), machineMutex(mutex) { }
 
     /**
      * Retrieve the machine portable machine wrapper.
@@ -86,8 +97,36 @@ public:
      * Constructor.
      *
      * @param mp a reference to a machine portable.
+     * @param mutex a reference to the mutex guarding the machine.
+     */
+    PredictProcessor(MachinePortable& mp, yarp::os::Mutex& mutex)
+      : IMachineProcessor(mp, mutex) { }
+
+    /*
+     * Inherited from PortReader.
+     */
+    virtual bool read(yarp::os::ConnectionReader& connection);
+};
+
+
+/**
+ * Port reader helper class for incoming models, which replaces the machine
+ * while holding the machine mutex.
+ *
+ * \see iCub::learningmachine::PredictModule
+ * \see iCub::learningmachine::IMachineProcessor
+ *
+ */
+class ModelProcessor : public IMachineProcessor, public yarp::os::PortReader {
+public:
+    /**
+     * Constructor.
+     *
+     * @param mp a reference to a machine portable.
+     * @param mutex a reference to the mutex guarding the machine.
      */
-    PredictProcessor(MachinePortable& mp) : IMachineProcessor(mp) { }
+    ModelProcessor(MachinePortable& mp, yarp::os::Mutex& mutex)
+      : IMachineProcessor(mp, mutex) { }
 
     /*
      * Inherited from PortReader.
@@ -123,11 +162,21 @@ protected:
      */
     MachinePortable machinePortable;
 
+    /**
+     * Mutex guarding the machine, shared by all processors.
+     */
+    yarp::os::Mutex machineMutex;
+
     /**
      * The processor handling prediction requests.
      */
     PredictProcessor predictProcessor;
 
+    /**
+     * The processor handling incoming models.
+     */
+    ModelProcessor modelProcessor;
+
     /**
      * Incoming port for the models from the train module.
      */
@@ -166,7 +215,8 @@ public:
      */
     PredictModule(std::string pp = "/lm/predict")
       : IMachineLearnerModule(pp), machinePortable((IMachineLearner*) 0),
-        predictProcessor(machinePortable) { }
+        predictProcessor(machinePortable, machineMutex),
+        modelProcessor(machinePortable, machineMutex) { }
 
     /**
      * Destructor (empty).
@@ -19,7 +19,12 @@
 #ifndef LM_TRAINMODULE__
 #define LM_TRAINMODULE__
 
+#include <deque>
+#include <string>
+
 #include <yarp/os/PortablePair.h>
+#include <yarp/os/Semaphore.h>
+#include <yarp/os/Thread.h>
 
 #include "iCub/learningMachine/PredictModule.h"
 
@@ -29,7 +34,13 @@ namespace learningmachine {
 
 
 /**
- * Port processor helper class for incoming training samples.
+ * Port processor helper class for incoming training samples. By default,
+ * samples are fed to the machine on the thread of the port reader. If a queue
+ * size is set, the processor runs in pipelined mode: the port reader only
+ * appends samples to a bounded queue and a separate thread feeds them to the
+ * machine, such that port reads and learning overlap. The port reader blocks
+ * when the queue is full. Samples still queued when the processor stops are
+ * fed to the machine before the thread ends.
  *
  * \see iCub::learningmachine::TrainModule
  * \see iCub::learningmachine::IMachineProcessor
@@ -37,20 +48,86 @@ namespace learningmachine {
  * \author Arjan Gijsberts
  *
  */
-class TrainProcessor : public IMachineProcessor, public yarp::os::TypedReaderCallback< yarp::os::PortablePair<yarp::sig::Vector,yarp::sig::Vector> > {
+class TrainProcessor : public IMachineProcessor, public yarp::os::TypedReaderCallback< yarp::os::PortablePair<yarp::sig::Vector,yarp::sig::Vector> >, public yarp::os::Thread {
 private:
+    /**
+     * A training sample waiting in the queue.
+     */
+    struct QueuedSample {
+        yarp::sig::Vector input;
+        yarp::sig::Vector output;
+        double stamp;
+    };
+
     /**
      * Boolean switch to disable and enable the sample stream to the machine.
      */
     bool enabled;
 
+    /**
+     * Maximum number of queued samples; zero disables pipelined mode.
+     */
+    unsigned int queueSize;
+
+    /**
+     * The queue of samples waiting to be fed to the machine.
+     */
+    std::deque<QueuedSample> queue;
+
+    /**
+     * Mutex guarding the queue and the statistics.
+     */
+    yarp::os::Semaphore queueMutex;
+
+    /**
+     * Counts the samples in the queue.
+     */
+    yarp::os::Semaphore itemsAvailable;
+
+    /**
+     * Counts the free slots in the queue.
+     */
+    yarp::os::Semaphore slotsAvailable;
+
+    /**
+     * Largest observed queue depth.
+     */
+    unsigned int maxDepth;
+
+    /**
+     * Number of samples fed to the machine.
+     */
+    unsigned int sampleCount;
+
+    /**
+     * Accumulated time samples spent in the queue.
+     */
+    double queueTime;
+
+    /**
+     * Accumulated time spent feeding samples to the machine.
+     */
+    double processTime;
+
+    /**
+     * Feeds a single sample to the machine and raises the training event.
+     *
+     * @param input the input of the sample
+     * @param output the output of the sample
+     */
+    void process(const yarp::sig::Vector& input, const yarp::sig::Vector& output);
+
 public:
     /**
      * Constructor.
      *
      * @param mp a reference to a machine portable.
+     * @param mutex a reference to the mutex guarding the machine.
      */
-    TrainProcessor(MachinePortable& mp) : IMachineProcessor(mp), enabled(true) { }
+    TrainProcessor(MachinePortable& mp, yarp::os::Mutex& mutex)
+      : IMachineProcessor(mp, mutex), enabled(true), queueSize(0),
+        queueMutex(1), itemsAvailable(0), slotsAvailable(0), maxDepth(0),
+        sampleCount(0), queueTime(0.), processTime(0.) { }
 
     /**
      * Enables or disables processing of training samples.
@@ -61,11 +138,42 @@ public:
         this->enabled = val;
     }
 
+    /**
+     * Sets the size of the sample queue. A size of zero processes samples on
+     * the port reader thread. The size can only be changed while the
+     * processing thread is not running.
+     *
+     * @param size the maximum number of queued samples
+     */
+    virtual void setQueueSize(unsigned int size);
+
+    /**
+     * Returns the size of the sample queue.
+     */
+    virtual unsigned int getQueueSize() {
+        return this->queueSize;
+    }
+
+    /**
+     * Returns a description of the queue depth and the time spent in each
+     * stage of the pipeline.
+     */
+    virtual std::string getStatistics();
+
     /*
      * Inherited from TypedReaderCallback.
      */
     virtual void onRead(yarp::os::PortablePair<yarp::sig::Vector,yarp::sig::Vector>& sample);
 
+    /*
+     * Inherited from Thread.
+     */
+    virtual void run();
+
+    /*
+     * Inherited from Thread.
+     */
+    virtual void onStop();
 };
 
 
@@ -142,7 +250,7 @@ public:
      * @param support an instance of the Support class.
      */
     TrainModule(std::string pp = "/lm/train")
-      : PredictModule(pp), trainProcessor(machinePortable) { }
+      : PredictModule(pp), trainProcessor(machinePortable, machineMutex) { }
 
     /**
      * Destructor (empty).
@@ -163,6 +271,11 @@ public:
      * Inherited from IMachineLearnerModule.
      */
     virtual bool respond(const yarp::os::Bottle& cmd, yarp::os::Bottle& reply);
+
+    /*
+     * Inherited from IMachineLearnerModule.
+     */
+    virtual bool close();
 };
 
 } // learningmachine
@@ -43,7 +43,10 @@ bool PredictProcessor::read(yarp::os::ConnectionReader& connection) {
         return false;
     }
     try {
-        prediction = this->getMachine().predict(input);
+        {
+            yarp::os::LockGuard lg(this->machineMutex);
+            prediction = this->getMachine().predict(input);
+        }
 
         // Event Code
         if(EventDispatcher::instance().hasListeners()) {
@@ -63,6 +66,18 @@ bool PredictProcessor::read(yarp::os::ConnectionReader& connection) {
     return true;
 }
 
+bool ModelProcessor::read(yarp::os::ConnectionReader& connection) {
+    bool ok;
+    yarp::os::LockGuard lg(this->machineMutex);
+    try {
+        ok = this->getMachinePortable().read(connection);
+    } catch(const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        ok = false;
+    }
+    return ok;
+}
+
 
 void PredictModule::printOptions(std::string error) {
     if(error != "") {
@@ -116,6 +131,7 @@ bool PredictModule::configure(yarp::os::ResourceFinder& opt) {
 
     // check for filename to load machine from
     if(opt.check("load", val)) {
+        yarp::os::LockGuard lg(this->machineMutex);
         this->getMachinePortable().readFromFile(val->asString().c_str());
     }
 
@@ -129,7 +145,7 @@ bool PredictModule::configure(yarp::os::ResourceFinder& opt) {
     }
 
     // add reader for models
-    this->model_in.setReader(this->machinePortable);
+    this->model_in.setReader(this->modelProcessor);
 
     // add replier for incoming data (prediction requests)
     this->predict_inout.setReplier(this->predictProcessor);
@@ -173,7 +189,10 @@ bool PredictModule::respond(const yarp::os::Bottle& cmd, yarp::os::Bottle& reply
             case VOCAB4('r','e','s','e'):
             case VOCAB3('r','s','t'):
                 {
-                this->getMachine().reset();
+                {
+                    yarp::os::LockGuard lg(this->machineMutex);
+                    this->getMachine().reset();
+                }
                 reply.addString("Machine reset.");
                 success = true;
                 break;
@@ -184,7 +203,10 @@ bool PredictModule::respond(const yarp::os::Bottle& cmd, yarp::os::Bottle& reply
                 {
                 reply.addVocab(yarp::os::Vocab::encode("help"));
                 reply.addString("Machine Information: ");
-                reply.addString(this->getMachine().getInfo().c_str());
+                {
+                    yarp::os::LockGuard lg(this->machineMutex);
+                    reply.addString(this->getMachine().getInfo().c_str());
+                }
                 success = true;
                 break;
                 }
@@ -197,7 +219,10 @@ bool PredictModule::respond(const yarp::os::Bottle& cmd, yarp::os::Bottle& reply
                 if(!cmd.get(1).isString()) {
                     replymsg += "failed";
                 } else {
-                    this->getMachinePortable().readFromFile(cmd.get(1).asString().c_str());
+                    {
+                        yarp::os::LockGuard lg(this->machineMutex);
+                        this->getMachinePortable().readFromFile(cmd.get(1).asString().c_str());
+                    }
                     replymsg += "succeeded";
                 }
                 reply.addString(replymsg.c_str());
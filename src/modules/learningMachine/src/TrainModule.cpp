@@ -17,10 +17,12 @@
  */
 
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <cassert>
 
 #include <yarp/os/Vocab.h>
+#include <yarp/os/Time.h>
 
 #include "iCub/learningMachine/TrainModule.h"
 #include "iCub/learningMachine/EventDispatcher.h"
@@ -29,25 +31,135 @@
 namespace iCub {
 namespace learningmachine {
 
+void TrainProcessor::process(const yarp::sig::Vector& input, const yarp::sig::Vector& output) {
+    yarp::os::LockGuard lg(this->machineMutex);
+    try {
+        // Event Code
+        if(EventDispatcher::instance().hasListeners()) {
+            Prediction prediction = this->getMachine().predict(input);
+            TrainEvent te(input, output, prediction);
+            EventDispatcher::instance().raise(te);
+        }
+        // Event Code
+
+        this->getMachine().feedSample(input, output);
+
+    } catch(const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+}
+
 void TrainProcessor::onRead(yarp::os::PortablePair<yarp::sig::Vector,yarp::sig::Vector>& sample) {
-    if(this->getMachinePortable().hasWrapped() && this->enabled) {
-        try {
-            // Event Code
-            if(EventDispatcher::instance().hasListeners()) {
-                Prediction prediction = this->getMachine().predict(sample.head);
-                TrainEvent te(sample.head, sample.body, prediction);
-                EventDispatcher::instance().raise(te);
-            }
-            // Event Code
-
-            this->getMachine().feedSample(sample.head, sample.body);
-
-        } catch(const std::exception& e) {
-            std::cerr << "Error: " << e.what() << std::endl;
+    if(!this->getMachinePortable().hasWrapped() || !this->enabled) {
+        return;
+    }
+
+    // once stopping, the queue is no longer served: feed the sample directly
+    if(this->queueSize == 0 || !this->isRunning() || this->isStopping()) {
+        double start = yarp::os::Time::now();
+        this->process(sample.head, sample.body);
+
+        this->queueMutex.wait();
+        this->processTime += yarp::os::Time::now() - start;
+        this->sampleCount++;
+        this->queueMutex.post();
+        return;
+    }
+
+    // block while the queue is full
+    this->slotsAvailable.wait();
+
+    this->queueMutex.wait();
+    this->queue.push_back(QueuedSample());
+    this->queue.back().input = sample.head;
+    this->queue.back().output = sample.body;
+    this->queue.back().stamp = yarp::os::Time::now();
+    if(this->queue.size() > this->maxDepth) {
+        this->maxDepth = this->queue.size();
+    }
+    this->queueMutex.post();
+
+    this->itemsAvailable.post();
+}
+
+void TrainProcessor::run() {
+    QueuedSample sample;
+    while(!this->isStopping()) {
+        this->itemsAvailable.wait();
+
+        this->queueMutex.wait();
+        if(this->queue.empty()) {
+            // woken up by onStop()
+            this->queueMutex.post();
+            continue;
         }
+        sample = this->queue.front();
+        this->queue.pop_front();
+        this->queueMutex.post();
+        this->slotsAvailable.post();
+
+        double start = yarp::os::Time::now();
+        this->process(sample.input, sample.output);
+        double end = yarp::os::Time::now();
+
+        this->queueMutex.wait();
+        this->queueTime += start - sample.stamp;
+        this->processTime += end - start;
+        this->sampleCount++;
+        this->queueMutex.post();
+    }
+
+    // feed the samples that were still queued, so that none is lost on stop
+    unsigned int drained = 0;
+    this->queueMutex.wait();
+    while(!this->queue.empty()) {
+        sample = this->queue.front();
+        this->queue.pop_front();
+        this->queueMutex.post();
+        this->slotsAvailable.post();
+
+        this->process(sample.input, sample.output);
+        drained++;
+
+        this->queueMutex.wait();
+        this->sampleCount++;
+    }
+    this->itemsAvailable.reset(0);
+    this->queueMutex.post();
+
+    if(drained > 0) {
+        std::cout << "Fed " << drained << " queued samples to the machine before stopping" << std::endl;
     }
+}
 
-    return;
+void TrainProcessor::onStop() {
+    // wake up the processing thread and a port reader waiting for a slot
+    this->itemsAvailable.post();
+    this->slotsAvailable.post();
+}
+
+void TrainProcessor::setQueueSize(unsigned int size) {
+    if(this->isRunning()) {
+        throw std::runtime_error("cannot change queue size while processing samples");
+    }
+    this->queueSize = size;
+    this->queue.clear();
+    this->itemsAvailable.reset(0);
+    this->slotsAvailable.reset(size);
+}
+
+std::string TrainProcessor::getStatistics() {
+    std::ostringstream buffer;
+    this->queueMutex.wait();
+    buffer << "Queue size: " << this->queueSize << std::endl;
+    buffer << "Queue depth: " << this->queue.size() << " (max " << this->maxDepth << ")" << std::endl;
+    buffer << "Samples processed: " << this->sampleCount << std::endl;
+    if(this->sampleCount > 0) {
+        buffer << "Mean queue latency: " << this->queueTime / this->sampleCount << " s" << std::endl;
+        buffer << "Mean training latency: " << this->processTime / this->sampleCount << " s" << std::endl;
+    }
+    this->queueMutex.post();
+    return buffer.str();
 }
 
 
@@ -62,6 +174,7 @@ void TrainModule::printOptions(std::string error) {
     std::cout << "--machine type         Desired type of learning machine" << std::endl;
     std::cout << "--port pfx             Prefix for registering the ports" << std::endl;
     std::cout << "--commands file        Load configuration commands from a file" << std::endl;
+    std::cout << "--queue n              Feed samples from a queue of size n on a separate thread" << std::endl;
 }
 
 
@@ -98,6 +211,12 @@ bool TrainModule::interruptModule() {
     return true;
 }
 
+bool TrainModule::close() {
+    // stop processing queued samples before the machine is closed
+    this->trainProcessor.stop();
+    return PredictModule::close();
+}
+
 bool TrainModule::configure(yarp::os::ResourceFinder& opt) {
     /* Implementation note:
      * Calling open() in the base class (i.e. PredictModule) is cumbersome due
@@ -155,6 +274,12 @@ bool TrainModule::configure(yarp::os::ResourceFinder& opt) {
     // add processor for incoming data (training samples)
     this->train_in.useCallback(trainProcessor);
 
+    // process training samples on a separate thread if requested
+    if(opt.check("queue", val) && val->asInt() > 0) {
+        this->trainProcessor.setQueueSize(val->asInt());
+        this->trainProcessor.start();
+    }
+
     // register ports before connecting
     this->registerAllPorts();
 
@@ -194,16 +319,25 @@ bool TrainModule::respond(const yarp::os::Bottle& cmd, yarp::os::Bottle& reply)
                 reply.addString("  save fname            Saves the current machine to a file");
                 reply.addString("  event [cmd ...]       Sends commands to event dispatcher (see: event help)");
                 reply.addString("  cmd fname             Loads commands from a file");
-                reply.addString(this->getMachine().getConfigHelp().c_str());
+                {
+                    yarp::os::LockGuard lg(this->machineMutex);
+                    reply.addString(this->getMachine().getConfigHelp().c_str());
+                }
                 success = true;
                 break;
 
             case VOCAB4('t','r','a','i'): // train the machine, implies sending model
-                this->getMachine().train();
+                {
+                    yarp::os::LockGuard lg(this->machineMutex);
+                    this->getMachine().train();
+                }
                 reply.addString("Training completed.");
 
             case VOCAB4('m','o','d','e'): // send model
-                this->model_out.write(this->machinePortable);
+                {
+                    yarp::os::LockGuard lg(this->machineMutex);
+                    this->model_out.write(this->machinePortable);
+                }
                 reply.addString("The model has been written to the port.");
                 success = true;
                 break;
@@ -212,7 +346,10 @@ bool TrainModule::respond(const yarp::os::Bottle& cmd, yarp::os::Bottle& reply)
             case VOCAB3('c','l','r'):
             case VOCAB4('r','e','s','e'): // reset
             case VOCAB3('r','s','t'):
-                this->getMachine().reset();
+                {
+                    yarp::os::LockGuard lg(this->machineMutex);
+                    this->getMachine().reset();
+                }
                 reply.addString("Machine cleared.");
                 success = true;
                 break;
@@ -236,7 +373,12 @@ bool TrainModule::respond(const yarp::os::Bottle& cmd, yarp::os::Bottle& reply)
                 { // prevent identifier initialization to cross borders of case
                 reply.add(yarp::os::Value::makeVocab("help"));
                 reply.addString("Machine Information: ");
-                reply.addString(this->getMachine().getInfo().c_str());
+                {
+                    yarp::os::LockGuard lg(this->machineMutex);
+                    reply.addString(this->getMachine().getInfo().c_str());
+                }
+                reply.addString("Sample Processing: ");
+                reply.addString(this->trainProcessor.getStatistics().c_str());
                 success = true;
                 break;
                 }
@@ -249,7 +391,10 @@ bool TrainModule::respond(const yarp::os::Bottle& cmd, yarp::os::Bottle& reply)
                 if(!cmd.get(1).isString()) {
                     replymsg += "failed";
                 } else {
-                    this->getMachinePortable().readFromFile(cmd.get(1).asString().c_str());
+                    {
+                        yarp::os::LockGuard lg(this->machineMutex);
+                        this->getMachinePortable().readFromFile(cmd.get(1).asString().c_str());
+                    }
                     replymsg += "succeeded";
                 }
                 reply.addString(replymsg.c_str());
@@ -265,7 +410,10 @@ bool TrainModule::respond(const yarp::os::Bottle& cmd, yarp::os::Bottle& reply)
                 if(!cmd.get(1).isString()) {
                     replymsg += "failed";
                 } else {
-                    this->getMachinePortable().writeToFile(cmd.get(1).asString().c_str());
+                    {
+                        yarp::os::LockGuard lg(this->machineMutex);
+                        this->getMachinePortable().writeToFile(cmd.get(1).asString().c_str());
+                    }
                     replymsg += "succeeded";
                 }
                 reply.addString(replymsg.c_str());
@@ -284,7 +432,11 @@ bool TrainModule::respond(const yarp::os::Bottle& cmd, yarp::os::Bottle& reply)
                  */
                 property.addList() = cmd.tail();
                 std::string replymsg = "Setting configuration option ";
-                bool ok = this->getMachine().configure(property);
+                bool ok;
+                {
+                    yarp::os::LockGuard lg(this->machineMutex);
+                    ok = this->getMachine().configure(property);
+                }
                 replymsg += ok ? "succeeded" :
                                  "failed; please check key and value type.";
                 reply.addString(replymsg.c_str());
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 Istituto Italiano di Tecnologia - iCub Facility
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+ */
+
+// e.g. ./lmconvert --input data.txt --output data.bin --inputs 3
+//      ./lmconvert --merge (a.bin b.bin c.bin) --output all.bin
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include <yarp/os/ResourceFinder.h>
+#include <yarp/os/Bottle.h>
+#include <yarp/os/Value.h>
+#include <yarp/sig/Vector.h>
+
+#include "iCub/learningMachine/BinaryDataset.h"
+
+using namespace yarp::os;
+using namespace yarp::sig;
+
+namespace iCub {
+namespace learningmachine {
+namespace convert {
+
+/**
+ * Number of bytes copied at once when merging binary datasets.
+ */
+const size_t CHUNK_SIZE = 1 << 20;
+
+void printOptions(std::string error = "") {
+    if(error != "") {
+        std::cerr << "Error: " << error << std::endl;
+    }
+    std::cout << "Converts text datasets to binary datasets and merges binary datasets." << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "--input file            Text dataset to convert" << std::endl;
+    std::cout << "--inputs n              Number of input columns in the text dataset" << std::endl;
+    std::cout << "--merge (f1 f2 ...)     Binary datasets to concatenate" << std::endl;
+    std::cout << "--output file           Binary dataset to write" << std::endl;
+}
+
+/**
+ * Converts a text dataset to a binary dataset, one line at a time. The first
+ * inputCount columns are taken as inputs and the remaining columns as
+ * outputs. Empty lines and lines starting with # are skipped.
+ */
+int convertText(const std::string& in, const std::string& out, unsigned int inputCount) {
+    std::ifstream source(in.c_str());
+    if(!source.is_open()) {
+        throw std::runtime_error("could not open file '" + in + "'");
+    }
+
+    std::ofstream dest(out.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    if(!dest.is_open()) {
+        throw std::runtime_error("could not open file '" + out + "'");
+    }
+
+    std::string lineString;
+    std::vector<double> values;
+    Vector input(inputCount);
+    Vector output;
+    bool first = true;
+    int count = 0;
+
+    while(getline(source, lineString)) {
+        if(lineString.empty() || lineString[0] == '#') {
+            continue;
+        }
+
+        values.clear();
+        std::istringstream lineStream(lineString);
+        double val;
+        while(lineStream >> val) {
+            values.push_back(val);
+        }
+        if(values.empty()) {
+            continue;
+        }
+        if(values.size() < inputCount) {
+            throw std::runtime_error("sample has fewer columns than the number of inputs");
+        }
+
+        // the first sample fixes the number of outputs
+        if(first) {
+            output.resize(values.size() - inputCount);
+            BinaryDataset::writeHeader(dest, inputCount, output.size());
+            first = false;
+        } else if(values.size() != inputCount + output.size()) {
+            throw std::runtime_error("samples in text dataset have varying numbers of columns");
+        }
+
+        for(size_t i = 0; i < input.size(); i++) {
+            input[i] = values[i];
+        }
+        for(size_t i = 0; i < output.size(); i++) {
+            output[i] = values[inputCount + i];
+        }
+        BinaryDataset::writeRow(dest, input, output);
+        count++;
+    }
+
+    if(first) {
+        throw std::runtime_error("text dataset '" + in + "' contains no samples");
+    }
+
+    std::cout << "Converted " << count << " samples (" << inputCount << " inputs, "
+              << output.size() << " outputs) to '" << out << "'" << std::endl;
+    return 0;
+}
+
+/**
+ * Concatenates binary datasets with equal dimensions. The datasets are
+ * copied in fixed size chunks, such that memory usage does not depend on the
+ * size of the datasets.
+ */
+int mergeBinary(const std::vector<std::string>& in, const std::string& out) {
+    std::ofstream dest(out.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    if(!dest.is_open()) {
+        throw std::runtime_error("could not open file '" + out + "'");
+    }
+
+    std::vector<char> chunk(CHUNK_SIZE);
+    char header[BinaryDataset::HEADER_SIZE];
+    unsigned int inputCount = 0, outputCount = 0;
+    size_t rowSize = 0;
+    size_t count = 0;
+
+    for(size_t f = 0; f < in.size(); f++) {
+        std::ifstream source(in[f].c_str(), std::ios_base::in | std::ios_base::binary);
+        if(!source.is_open()) {
+            throw std::runtime_error("could not open file '" + in[f] + "'");
+        }
+
+        unsigned int ic, oc;
+        if(!source.read(header, BinaryDataset::HEADER_SIZE) ||
+           !BinaryDataset::readHeader(header, ic, oc)) {
+            throw std::runtime_error("file '" + in[f] + "' is not a binary dataset");
+        }
+
+        if(f == 0) {
+            inputCount = ic;
+            outputCount = oc;
+            rowSize = (inputCount + outputCount) * sizeof(double);
+            BinaryDataset::writeHeader(dest, inputCount, outputCount);
+        } else if(ic != inputCount || oc != outputCount) {
+            throw std::runtime_error("dimensions of '" + in[f] + "' do not match previous datasets");
+        }
+
+        // copy whole rows only, dropping a trailing partial row if present
+        source.seekg(0, std::ios_base::end);
+        size_t bytes = size_t(source.tellg()) - BinaryDataset::HEADER_SIZE;
+        source.seekg(BinaryDataset::HEADER_SIZE, std::ios_base::beg);
+        if(rowSize > 0 && bytes % rowSize != 0) {
+            std::cerr << "Warning: '" << in[f] << "' ends with a partial sample" << std::endl;
+            bytes -= bytes % rowSize;
+        }
+        for(size_t remaining = bytes; remaining > 0; ) {
+            size_t n = (remaining < chunk.size()) ? remaining : chunk.size();
+            if(!source.read(&chunk[0], n)) {
+                throw std::runtime_error("could not read from file '" + in[f] + "'");
+            }
+            dest.write(&chunk[0], n);
+            remaining -= n;
+        }
+        count += (rowSize > 0) ? bytes / rowSize : 0;
+    }
+
+    std::cout << "Merged " << count << " samples from " << in.size()
+              << " datasets into '" << out << "'" << std::endl;
+    return 0;
+}
+
+} // convert
+} // learningmachine
+} // iCub
+
+using namespace iCub::learningmachine::convert;
+
+int main(int argc, char *argv[]) {
+    ResourceFinder rf;
+    rf.setDefaultContext("learningMachine");
+    rf.configure(argc, argv);
+
+    try {
+        if(rf.check("help") || !rf.check("output")) {
+            printOptions(rf.check("help") ? "" : "Please supply an output file!");
+            return rf.check("help") ? 0 : 1;
+        }
+        std::string out = rf.find("output").asString().c_str();
+
+        if(rf.check("merge")) {
+            Bottle* list = rf.find("merge").asList();
+            if(list == (Bottle*) 0 || list->size() == 0) {
+                printOptions("The merge option must be a list of files!");
+                return 1;
+            }
+            std::vector<std::string> in;
+            for(int i = 0; i < list->size(); i++) {
+                in.push_back(list->get(i).asString().c_str());
+            }
+            return mergeBinary(in, out);
+        }
+
+        if(rf.check("input") && rf.find("inputs").isInt() && rf.find("inputs").asInt() >= 0) {
+            return convertText(rf.find("input").asString().c_str(), out,
+                               rf.find("inputs").asInt());
+        }
+
+        printOptions("Please supply either an input file and number of inputs, or a list of files to merge!");
+        return 1;
+    } catch(const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -139,6 +139,7 @@ private:
 
     // SKIN EVENTS
     bool skinEventsOn;
+    bool binarySkinEvents;              // if true the skin events are sent with the binary encoding
 
 	/* ports */
     BufferedPort<skinContactList> skinEventsPort;   // skin events output port
@@ -39,6 +39,7 @@
 
 #include "iCub/skinDynLib/skinContact.h"
 #include "iCub/skinDynLib/skinContactList.h"
+#include "iCub/skinDynLib/skinPackedData.h"
 #include "iCub/skinDynLib/rpcSkinManager.h"
 #include "iCub/skinDynLib/common.h"
 
@@ -71,7 +72,12 @@ private:
     unsigned int linkNum;                       // number of the link
 
     // SKIN CONTACTS
-    vector< list<int> >     neighborsXtaxel;    // list of neighbors for each taxel    
+    bool                    allNeighbors;       // true if every taxel is neighbor with all the other taxels (no poses yet)
+    bool                    neighborsDirty;     // true if a taxel moved since the neighbor lists were built
+    vector<unsigned int>    neighborsStart;     // neighbors of taxel i are neighbors[neighborsStart[i]..neighborsStart[i+1]-1]
+    vector<unsigned int>    neighbors;          // neighbor lists of all the taxels, stored contiguously (CSR)
+    vector<int>             parentXtaxel;       // union-find parent of each active taxel (-1 for inactive taxels)
+    vector<int>             contactXroot;       // contact id of each union-find root (-1 if not assigned yet)
 	vector<Vector>          taxelPos;		    // taxel positions {xPos, yPos, zPos}
     vector<Vector>          taxelOri;		    // taxel normals {xOri, yOri, zOri}
 	Vector					taxelPoseConfidence;// taxels pose estimation confidence 
@@ -79,11 +85,14 @@ private:
     Semaphore               poseSem;            // mutex to access taxel poses
 
 	// COMPENSATION
-	vector<bool> touchDetected;					// true if touch has been detected in the last read of the taxel
-	vector<bool> touchDetectedFilt;             // true if touch has been detected after applying the filtering
-    vector<bool> subTouchDetected;              // true if the taxel value has gone under the baseline (because of touch in neighbouring taxels)
+    // the taxel state is kept as a structure of arrays (one contiguous array per field)
+    // and flags are stored as bytes rather than packed bits, so that the compensation loop vectorizes
+	vector<unsigned char> touchDetected;		// true if touch has been detected in the last read of the taxel
+	vector<unsigned char> touchDetectedFilt;    // true if touch has been detected after applying the filtering
+    vector<unsigned char> subTouchDetected;     // true if the taxel value has gone under the baseline (because of touch in neighbouring taxels)
     Vector rawData;                             // data read from the skin
     Vector touchThresholds;						// thresholds for discriminating between "touch" and "no touch"
+    Vector invTouchThresholds;                  // inverse of the touch thresholds (used by the baseline update)
 	Semaphore touchThresholdSem;				// semaphore for controlling the access to the touchThreshold
     Vector initialBaselines;					// mean of the raw tactile data computed during calibration
     Vector baselines;							// mean of the raw tactile data     
@@ -118,8 +127,9 @@ private:
 
 	/* ports */
 	BufferedPort<Vector> compensatedTactileDataPort;	// output port
+    BufferedPort<skinPackedData> compensatedTactileDataPackedPort;  // output port with one byte per taxel
     BufferedPort<Bottle>* infoPort;					    // info output port
-    BufferedPort<Vector> inputPort;
+    BufferedPort<skinPackedData> inputPort;             // accepts both packed data and vectors
     Stamp timestamp;    // timestamp of last data read from inputPort
 
 	
@@ -127,8 +137,10 @@ private:
     bool init(string name, string robotName, string outputPortName, string inputPortName);
     bool readInputData(Vector& skin_values);
     void sendInfoMsg(string msg);
+    void reportNegativeBaselines();
     void computeNeighbors();
 	void updateNeighbors(unsigned int taxelId);
+    void buildNeighbors();
 
 	/* class methods */
 public:
@@ -140,7 +152,7 @@ public:
 	void calibrationInit();
 	void calibrationDataCollection();
 	void calibrationFinish();
-    bool readRawAndWriteCompensatedData();
+    bool readRawAndWriteCompensatedData(bool updateBaselines=false);
 	void updateBaseline();
 	bool doesBaselineExceed(unsigned int &taxelIndex, double &baseline, double &initialBaseline);
     skinContactList getContacts();
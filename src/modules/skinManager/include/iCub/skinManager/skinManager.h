@@ -125,6 +125,9 @@ These are the parameters of this section:
     missing calibration procedure for that skin part).
  - \c maxNeighborDist \c 0.015 \n
     maximum distance between two neighbor tactile sensors (in meters).
+ - \c binaryEvents \c 0 \n
+    if 1 the skin events are sent with the flat binary encoding of iCub::skinDynLib::skinContactList,
+    which is faster to encode and decode; the receivers must use a version of skinDynLib that supports it.
  
 
 \section portsa_sec Ports Accessed
@@ -141,6 +144,9 @@ will be accessed.
 \section portsc_sec Ports Created
 <b>Output ports </b>
 - Every port specified in the "outputPorts" parameter: outputs a yarp::sig::Vector containing the compensated tactile data.
+- For every port specified in the "outputPorts" parameter a port with the same name plus "_packed": 
+    outputs a iCub::skinDynLib::skinPackedData containing the compensated tactile data with one byte per taxel
+    (sparse encoding when few taxels are active); it is written only when it has connections.
 - "/"+moduleName+"/monitor:o": \n 
     outputs a yarp::os::Bottle containing streaming information regarding the compensation status 
     (used to communicate with the \ref icub_skinManagerGui). The first value is the data frequency, while
@@ -155,6 +161,7 @@ will be accessed.
 <b>Input ports</b>
 - For each port specified in the "inputPorts" parameter a local port is created with the name
   "/"+moduleName+index+"/input", where "index" is an increasing counter starting from 0.
+  These ports accept both yarp::sig::Vector and iCub::skinDynLib::skinPackedData.
 - "/"+moduleName+"/rpc:i": input port to control the module (alternatively the \ref icub_skinManagerGui can be used). 
     This port accepts a yarp::os::yarp::os::Bottle that contains one of these commands:
 	- calib: force the sensor calibration
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Istituto Italiano di Tecnologia - iCub Facility
+ * CopyPolicy: Released under the terms of the GNU GPL v2.0.
+ */
+#ifndef __TAXEL_NEIGHBORS_H__
+#define __TAXEL_NEIGHBORS_H__
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+namespace iCub{
+
+namespace skinManager{
+
+namespace detail{
+    // voxel of the grid used to look up neighboring taxels
+    struct TaxelCell{
+        long x, y, z;
+        unsigned int taxelId;
+        bool operator<(const TaxelCell &c) const{
+            if(x!=c.x) return x<c.x;
+            if(y!=c.y) return y<c.y;
+            return z<c.z;
+        }
+    };
+}
+
+/**
+ * Build the neighbor lists of the taxels, i.e. for each taxel the other taxels within maxDist.
+ * The taxels are hashed into a voxel grid with cells as large as maxDist, so that the neighbors
+ * of a taxel can only be in the 27 cells around it.
+ * @param pos the taxel positions, pos[i][0..2] (any container indexable this way)
+ * @param n the number of taxels
+ * @param maxDist the max distance between two neighbor taxels
+ * @param start output: the neighbors of taxel i are neighbors[start[i]..start[i+1]-1]
+ * @param neighbors output: the neighbor lists of all the taxels, stored contiguously (CSR)
+ */
+template<class Positions>
+void buildTaxelNeighbors(const Positions &pos, unsigned int n, double maxDist,
+                         std::vector<unsigned int> &start, std::vector<unsigned int> &neighbors){
+    double d2 = maxDist*maxDist;
+    double cellSize = maxDist>0.0 ? maxDist : 1.0;
+    std::vector<detail::TaxelCell> cells(n);
+    for(unsigned int i=0; i<n; i++){
+        cells[i].x = (long)std::floor(pos[i][0]/cellSize);
+        cells[i].y = (long)std::floor(pos[i][1]/cellSize);
+        cells[i].z = (long)std::floor(pos[i][2]/cellSize);
+        cells[i].taxelId = i;
+    }
+    std::vector<detail::TaxelCell> sortedCells(cells);
+    std::sort(sortedCells.begin(), sortedCells.end());
+
+    start.resize(n+1);
+    neighbors.clear();
+    detail::TaxelCell key;
+    double dx, dy, dz;
+    for(unsigned int i=0; i<n; i++){
+        start[i] = neighbors.size();
+        for(key.x=cells[i].x-1; key.x<=cells[i].x+1; key.x++)
+        for(key.y=cells[i].y-1; key.y<=cells[i].y+1; key.y++)
+        for(key.z=cells[i].z-1; key.z<=cells[i].z+1; key.z++){
+            std::pair<std::vector<detail::TaxelCell>::iterator, std::vector<detail::TaxelCell>::iterator> range =
+                std::equal_range(sortedCells.begin(), sortedCells.end(), key);
+            for(std::vector<detail::TaxelCell>::iterator it=range.first; it!=range.second; it++){
+                unsigned int j = it->taxelId;
+                if(j==i) continue;
+                dx = pos[i][0]-pos[j][0];
+                dy = pos[i][1]-pos[j][1];
+                dz = pos[i][2]-pos[j][2];
+                if(dx*dx+dy*dy+dz*dz <= d2)
+                    neighbors.push_back(j);
+            }
+        }
+    }
+    start[n] = neighbors.size();
+}
+
+/**
+ * Find the root of the contact of a taxel in the union-find forest, compressing the path.
+ */
+inline int findContactRoot(std::vector<int> &parent, int taxelId){
+    int root = taxelId;
+    while(parent[root]!=root)
+        root = parent[root];
+    // path compression
+    while(parent[taxelId]!=root){
+        int next = parent[taxelId];
+        parent[taxelId] = root;
+        taxelId = next;
+    }
+    return root;
+}
+
+/**
+ * Join the active taxels that are neighbors into the same union-find tree, so that the cost
+ * depends on the active taxels only. The parent of the inactive taxels must be -1.
+ * When allNeighbors is true every taxel is neighbor with all the others (the lists are not used).
+ */
+inline void mergeActiveTaxels(const std::vector<unsigned int> &activeList, bool allNeighbors,
+                              const std::vector<unsigned int> &start, const std::vector<unsigned int> &neighbors,
+                              std::vector<int> &parent){
+    for(unsigned int a=0; a<activeList.size(); a++)
+        parent[activeList[a]] = activeList[a];
+    for(unsigned int a=0; a<activeList.size(); a++){
+        unsigned int i = activeList[a];
+        if(allNeighbors){
+            parent[i] = activeList[0];
+            continue;
+        }
+        for(unsigned int k=start[i]; k<start[i+1]; k++){
+            if(parent[neighbors[k]] < 0)                // ** neighbor is not active
+                continue;
+            int root = findContactRoot(parent, i);
+            int neighRoot = findContactRoot(parent, neighbors[k]);
+            if(root!=neighRoot)                         // ** merge 2 contacts (the smallest id becomes the root)
+                parent[std::max(root, neighRoot)] = std::min(root, neighRoot);
+        }
+    }
+}
+
+/**
+ * Collect the taxels of each contact, numbering the contacts in order of their first taxel,
+ * and reset the union-find state of the active taxels (parent and contactXroot back to -1).
+ */
+inline void groupActiveTaxels(const std::vector<unsigned int> &activeList, std::vector<int> &parent,
+                              std::vector<int> &contactXroot,
+                              std::vector< std::vector<unsigned int> > &taxelsXcontact){
+    taxelsXcontact.clear();
+    for(unsigned int a=0; a<activeList.size(); a++){
+        int root = findContactRoot(parent, activeList[a]);
+        if(contactXroot[root]<0){
+            contactXroot[root] = taxelsXcontact.size();
+            taxelsXcontact.resize(taxelsXcontact.size()+1);
+        }
+        taxelsXcontact[contactXroot[root]].push_back(activeList[a]);
+    }
+    for(unsigned int a=0; a<activeList.size(); a++){
+        parent[activeList[a]] = -1;
+        contactXroot[activeList[a]] = -1;
+    }
+}
+
+} //namespace skinManager
+
+} //namespace iCub
+
+#endif
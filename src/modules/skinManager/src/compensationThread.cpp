@@ -135,6 +135,7 @@ bool CompensationThread::threadInit()
 
     // configure the SKIN_EVENT if the corresponding section exists
     skinEventsOn = false;
+    binarySkinEvents = false;
 	Bottle &skinEventsConf = rf->findGroup("SKIN_EVENTS");
 	if(!skinEventsConf.isNull()){
         yDebug("SKIN_EVENTS section found");
@@ -144,6 +145,11 @@ bool CompensationThread::threadInit()
         else
             skinEventsOn = true;
 
+        // the binary encoding can be read only by receivers that use an up-to-date skinDynLib
+        binarySkinEvents = skinEventsConf.check("binaryEvents", Value(0)).asInt()!=0;
+        if(binarySkinEvents)
+            yInfo("Skin events are sent with the binary encoding\n");
+
         if(skinEventsConf.check("skinParts")){
             Bottle* skinPartList = skinEventsConf.find("skinParts").asList();
             if(skinPartList->size() != portNum){
@@ -211,10 +217,8 @@ void CompensationThread::run(){
 		// and outputs these values
         FOR_ALL_PORTS(i){
             if(compWorking[i]){
-		        if(compensators[i]->readRawAndWriteCompensatedData()){
-			        //If the read succeeded, update the baseline
-			        compensators[i]->updateBaseline();
-		        }
+		        // the baseline is updated in the same pass, if the read succeeded
+		        compensators[i]->readRawAndWriteCompensatedData(true);
             }
         }
 
@@ -252,6 +256,7 @@ void CompensationThread::run(){
 void CompensationThread::sendSkinEvents(){
     skinContactList &skinEvents = skinEventsPort.prepare();
     skinEvents.clear();
+    skinEvents.setBinaryEncoding(binarySkinEvents);
 
     skinContactList temp;
     Stamp timestamp;
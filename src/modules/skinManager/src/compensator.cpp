@@ -21,6 +21,7 @@
 #include "math.h"
 #include <algorithm>
 #include "iCub/skinManager/compensator.h"
+#include "iCub/skinManager/taxelNeighbors.h"
 
 
 using namespace std;
@@ -54,6 +55,8 @@ Compensator::~Compensator(){
 
     compensatedTactileDataPort.interrupt();
     compensatedTactileDataPort.close();
+    compensatedTactileDataPackedPort.interrupt();
+    compensatedTactileDataPackedPort.close();
 }
 
 bool Compensator::init(string name, string robotName, string outputPortName, string inputPortName){
@@ -65,6 +68,12 @@ bool Compensator::init(string name, string robotName, string outputPortName, str
         sendInfoMsg(msg.str());
 	    return false;  // unable to open
     }
+    string packedPortName = outputPortName+"_packed";
+    if (!compensatedTactileDataPackedPort.open(packedPortName.c_str())) {
+	    stringstream msg; msg<< "Unable to open output port "<< packedPortName;
+        sendInfoMsg(msg.str());
+	    return false;  // unable to open
+    }
 
     Property options;
     stringstream localPortName;
@@ -123,6 +132,7 @@ bool Compensator::init(string name, string robotName, string outputPortName, str
     rawData.resize(skinDim);
     baselines.resize(skinDim);
     touchThresholds.resize(skinDim);
+    invTouchThresholds.resize(skinDim, 0.0);
     touchDetected.resize(skinDim);
     subTouchDetected.resize(skinDim);
     touchDetectedFilt.resize(skinDim);
@@ -134,11 +144,12 @@ bool Compensator::init(string name, string robotName, string outputPortName, str
 	taxelPoseConfidence.resize(skinDim,0.0);
     maxNeighDist = MAX_NEIGHBOR_DISTANCE;
     // by default every taxel is neighbor with all the other taxels
-    list<int> defaultNeighbors(skinDim);
-    int i=0;
-    for(list<int>::iterator it=defaultNeighbors.begin();it!=defaultNeighbors.end();it++, i++) 
-        *it = i;
-    neighborsXtaxel.resize(skinDim, defaultNeighbors);
+    allNeighbors = true;
+    neighborsDirty = false;
+    neighborsStart.assign(skinDim+1, 0);
+    neighbors.clear();
+    parentXtaxel.assign(skinDim, -1);
+    contactXroot.assign(skinDim, -1);
 
     // test read to check if the skin is broken (all taxel output is 0)
     if(robotName!="icubSim" && readInputData(compensatedData)){
@@ -251,8 +262,10 @@ void Compensator::calibrationFinish(){
 //        if(thresholdZero)
 //            sendInfoMsg("The noise of all taxels is 0. Probably there is a hardware problem.");
     }
-    for (unsigned int i=0; i<skinDim; i++) 
+    for (unsigned int i=0; i<skinDim; i++){
         touchThresholds[i] = max<double>(MIN_TOUCH_THR, touchThresholds[i]);
+        invTouchThresholds[i] = 1.0/touchThresholds[i];
+    }
 
     // print to console
     /*if(_isWorking){
@@ -276,7 +289,7 @@ void Compensator::calibrationFinish(){
 }
 
 bool Compensator::readInputData(Vector& skin_values){
-    Vector *tmp=0;
+    skinPackedData *tmp=0;
     if((tmp=inputPort.read(false))==0){
         readErrorCounter++;
         if(readErrorCounter>MAX_READ_ERROR){
@@ -288,7 +301,7 @@ bool Compensator::readInputData(Vector& skin_values){
     //try to read envelope of input data port
     inputPort.getEnvelope(timestamp);
 
-    skin_values = *tmp; // copy data
+    tmp->toVector(skin_values); // copy data
 
     if(skin_values.size() != skinDim){
         readErrorCounter++;
@@ -337,54 +350,95 @@ bool Compensator::readInputData(Vector& skin_values){
     return true;*/
 }
 
-bool Compensator::readRawAndWriteCompensatedData(){    
+bool Compensator::readRawAndWriteCompensatedData(bool updateBaselines){
     if(!readInputData(rawData))
         return false;
 	
 	Vector& compensatedData2Send = compensatedTactileDataPort.prepare();
     compensatedData2Send.resize(skinDim);   // local variable with data to send
 	compensatedData.resize(skinDim);        // global variable with data to store
-	
-	double d;
+
+    // take a snapshot of the parameters, so that the loop below runs without locking
+    smoothFactorSem.wait();
+    const double sf         = smoothFilter ? smoothFactor : 0.0;
+    smoothFactorSem.post();
+    const bool smooth       = smoothFilter;
+    const bool bin          = binarization;
+    const double addThr     = addThreshold;
+    const double rawOffset  = zeroUpRawData ? 0.0 : MAX_SKIN;
+    const double rawSign    = zeroUpRawData ? 1.0 : -1.0;
+    const double touchGain  = contactCompensationGain*0.02;
+    const double noTouchGain= compensationGain*0.02;
+
+    // raw pointers into the taxel state arrays, so that the compiler can vectorize the loop
+    const double *raw       = rawData.data();
+    const double *thr       = touchThresholds.data();
+    const double *invThr    = invTouchThresholds.data();
+    double *base            = baselines.data();
+    double *comp            = compensatedData.data();
+    double *old             = compensatedDataOld.data();
+    double *filt            = compensatedDataFilt.data();
+    double *out             = compensatedData2Send.data();
+    unsigned char *touch    = &touchDetected[0];
+    unsigned char *subTouch = &subTouchDetected[0];
+    unsigned char *touchFilt= &touchDetectedFilt[0];
+    double minBase          = MAX_SKIN;
+
+	double d, t;
 	for(unsigned int i=0; i<skinDim; i++){
 	    // baseline compensation
-		d =  (double)( zeroUpRawData ? rawData(i)-baselines[i] : MAX_SKIN-rawData(i)-baselines[i] );
-	    d =   min<double>( MAX_SKIN, d);
-	    compensatedData[i] = d;     // save the data before applying filtering
-
-        // detect touch (before applying filtering, so the compensation algorithm is not affected by the filters)
-		touchDetected[i] = (d > touchThresholds[i] + addThreshold);
-	    
-        // detect subtouch
-		subTouchDetected[i] = (d < -touchThresholds[i] - addThreshold);
+		d = rawOffset + rawSign*raw[i] - base[i];
+	    d = d<MAX_SKIN ? d : MAX_SKIN;
+	    comp[i] = d;     // save the data before applying filtering
+
+        // detect touch and subtouch (before applying filtering, so the compensation algorithm is not affected by the filters)
+        t = thr[i] + addThr;
+		touch[i] = d > t;
+		subTouch[i] = d < -t;
 	    
         // smooth filter
-        if(smoothFilter){
-		    smoothFactorSem.wait();
-		    d = (1-smoothFactor)*d + smoothFactor*compensatedDataOld(i);
-		    smoothFactorSem.post();
-		    compensatedDataOld(i) = d;	// update old value
+        if(smooth){
+		    d = (1-sf)*d + sf*old[i];
+		    old[i] = d;	// update old value
 	    }
-        compensatedDataFilt[i] = d;
+        filt[i] = d;
 
 	    // binarization filter
         // here we don't use the touchDetected array because, if the smooth filter is on,
         // we want to use the filtered values
-        touchDetectedFilt[i] = (d > touchThresholds[i] + addThreshold);
-        if(binarization)
-		    d = ( touchDetectedFilt[i] ? BIN_TOUCH : BIN_NO_TOUCH );
+        touchFilt[i] = d > t;
+        if(bin)
+		    d = touchFilt[i] ? BIN_TOUCH : BIN_NO_TOUCH;
         
-	    compensatedData2Send[i] = max<double>(0.0, d); // trim only data to send because you need negative values for update baseline
+	    out[i] = d>0.0 ? d : 0.0; // trim only data to send because you need negative values for update baseline
+
+        // baseline drift compensation, using the unfiltered compensated value
+        if(updateBaselines){
+            base[i] += (touch[i] ? touchGain : noTouchGain)*comp[i]*invThr[i];
+            minBase = base[i]<minBase ? base[i] : minBase;
+        }
 	}
 
 	compensatedTactileDataPort.write();
+
+    // the packed output is only computed if someone reads it
+    if(compensatedTactileDataPackedPort.getOutputCount()>0){
+        skinPackedData& packedData2Send = compensatedTactileDataPackedPort.prepare();
+        packedData2Send.setSparse(true);
+        packedData2Send.fromVector(compensatedData2Send);
+        compensatedTactileDataPackedPort.setEnvelope(timestamp);
+        compensatedTactileDataPackedPort.write();
+    }
+
+    if(minBase<0)
+        reportNegativeBaselines();
 	return true;
 }
 
 void Compensator::updateBaseline(){
-	double mean_change = 0, change, gain;
-    unsigned int non_touching_taxels = 0;
-	double d; 
+    const double touchGain  = contactCompensationGain*0.02;
+    const double noTouchGain= compensationGain*0.02;
+    double minBase          = MAX_SKIN;
 
     for(unsigned int j=0; j<skinDim; j++) {
         // *** Algorithm 1
@@ -409,28 +463,13 @@ void Compensator::updateBaseline(){
 			}
 		}*/
     
-        d = compensatedData(j);
-        if(touchDetected[j]){
-            gain            = contactCompensationGain*0.02;                
-        }else{
-            gain            = compensationGain*0.02;
-            non_touching_taxels++;
-        }
-        change          = gain*d/touchThresholds[j];
-		baselines[j]    += change;
-        mean_change     += change;
+		baselines[j]    += (touchDetected[j] ? touchGain : noTouchGain)*compensatedData[j]*invTouchThresholds[j];
+        minBase         = min<double>(minBase, baselines[j]);
+    }
 
-    //        if(j<5)
-    //        printf("%d touch detected %s, change %.6f, gain: %.3f\n", j, touchDetected[j]?"yes":"no", change, touchDetected[j]?contactCompensationGain:compensationGain);
+    if(minBase<0)
+        reportNegativeBaselines();
 
-        if(baselines[j]<0){
-            char* temp = new char[300];
-            sprintf(temp, "ERROR-Negative baseline. Port %s; tax %d; baseline %.2f; gain: %.4f; d: %.2f; raw: %.2f; change: %f; touchThr: %.2f", 
-                SkinPart_s[skinPart].c_str(), j, baselines[j], gain, d, rawData[j], change, touchThresholds[j]);
-            sendInfoMsg(temp);
-        }      
-    }
-    
     //for compensating the taxels where we detected touch
     /*if (non_touching_taxels>0 && non_touching_taxels<skinDim && mean_change!=0){
         mean_change /= non_touching_taxels;
@@ -447,6 +486,17 @@ void Compensator::updateBaseline(){
     }*/
 }
 
+void Compensator::reportNegativeBaselines(){
+    char temp[300];
+    for(unsigned int j=0; j<skinDim; j++){
+        if(baselines[j]<0){
+            sprintf(temp, "ERROR-Negative baseline. Port %s; tax %d; baseline %.2f; d: %.2f; raw: %.2f; touchThr: %.2f", 
+                SkinPart_s[skinPart].c_str(), j, baselines[j], compensatedData[j], rawData[j], touchThresholds[j]);
+            sendInfoMsg(temp);
+        }
+    }
+}
+
 bool Compensator::doesBaselineExceed(unsigned int &taxelIndex, double &baseline, double &initialBaseline){
     vector<unsigned int>::iterator it;
 	for(unsigned int i=0; i<skinDim; i++){
@@ -466,68 +516,45 @@ bool Compensator::doesBaselineExceed(unsigned int &taxelIndex, double &baseline,
 }
 
 skinContactList Compensator::getContacts(){    
-    vector<int>         contactXtaxel(skinDim, -1);     // contact for each taxel (-1 means no contact)
-    deque<deque<int> >  taxelsXcontact;                 // taxels for each contact
-    int                 contactId = 0;                  // id of the next contact to create
-    int                 neighCont;                      // id of the contact of the current neighbor
+    vector<unsigned int>            activeList;         // ids of the active taxels
+    vector< vector<unsigned int> >  taxelsXcontact;     // taxels for each contact
+
+    if(parentXtaxel.size()<skinDim){
+        parentXtaxel.resize(skinDim, -1);
+        contactXroot.resize(skinDim, -1);
+    }
+    for(unsigned int i=0; i<skinDim; i++)
+        if(touchDetectedFilt[i])
+            activeList.push_back(i);
 
     poseSem.wait();
     {
-        for(unsigned int i=0; i<skinDim; i++){
-            if(touchDetectedFilt[i] ){ // && contactXtaxel[i]<0 (second condition should always be true)
-                list<int> *neighbors = &(neighborsXtaxel[i]);
-                //printf("Taxel %d active. Going to check its %d neighbors\n", i, neighbors->size());
-                for(list<int>::iterator it=neighbors->begin(); it!=neighbors->end(); it++){
-                    neighCont = contactXtaxel[(*it)];
-                    if(neighCont >= 0){                                     // ** if neighbor belongs to a contact
-                        if(contactXtaxel[i]<0){                             // ** add taxel to pre-existing contact
-                            contactXtaxel[i] = neighCont;
-                            taxelsXcontact[neighCont].push_back(i);
-                            //printf("Add taxel to pre existing contact %d (neighbor %d)\n", neighCont, (*neighbors)[n]);
-                        }else if(contactXtaxel[i]!=neighCont){              // ** merge 2 contacts
-                            //mergeContacts(contactXtaxel[i], neighCont);
-                            int newId = min(contactXtaxel[i], neighCont);
-                            int oldId = max(contactXtaxel[i], neighCont);
-                            deque<int> tax2move = taxelsXcontact[oldId];
-                            for(deque<int>::iterator it=tax2move.begin(); it!=tax2move.end(); it++){
-                                contactXtaxel[(*it)] = newId;               // assign new contact id
-                                taxelsXcontact[newId].push_back((*it));     // add taxel ids to contact
-                            }
-                            taxelsXcontact[oldId].clear();      // clear the list of taxels belonging to the merged contact
-                            //printf("Merge two contacts: %d and %d\n", oldId, newId);
-                        }
-                    }
+        // taxels moved one at a time are taken into account here, with a single rebuild
+        if(neighborsDirty && !activeList.empty())
+            buildNeighbors();
 
-                }
-                if(contactXtaxel[i]<0){            // ** if no neighbor belongs to a contact -> create new contact
-                    contactXtaxel[i] = contactId;
-                    taxelsXcontact.resize(contactId+1);
-                    taxelsXcontact[contactId].push_back(i);
-                    contactId++;
-                    //printf("New contact created: %d\n", contactId-1);
-                }
-            }
-        }
+        // union-find over the active taxels, so that the cost depends on the active taxels only
+        mergeActiveTaxels(activeList, allNeighbors, neighborsStart, neighbors, parentXtaxel);
     }
     poseSem.post();
 
+    // contacts are numbered in order of their first taxel
+    groupActiveTaxels(activeList, parentXtaxel, contactXroot, taxelsXcontact);
+
     skinContactList contactList;
     Vector CoP(3), geoCenter(3), normal(3);
     double pressure, pressureCoP, pressureNormal, out;
-    int activeTaxels, activeTaxelsGeo;
-    vector<unsigned int> taxelList;
-    for( deque<deque<int> >::iterator it=taxelsXcontact.begin(); it!=taxelsXcontact.end(); it++){
-        activeTaxels = it->size();
-        if(activeTaxels==0) continue;
-        
-        taxelList.resize(activeTaxels);
+    int activeTaxelsGeo;
+    for( vector< vector<unsigned int> >::iterator it=taxelsXcontact.begin(); it!=taxelsXcontact.end(); it++){
+        int activeTaxels = it->size();
+        vector<unsigned int> &taxelList = *it;
+
         CoP.zero();
         geoCenter.zero();
         normal.zero();
         pressure = pressureCoP = pressureNormal = 0.0;
         activeTaxelsGeo = 0;
-        int i=0;
-        for( deque<int>::iterator tax=it->begin(); tax!=it->end(); tax++, i++){
+        for( vector<unsigned int>::iterator tax=it->begin(); tax!=it->end(); tax++){
             out         = max(compensatedDataFilt[(*tax)], 0.0);
             if(norm(taxelPos[(*tax)])!=0.0){  // if the taxel position estimate exists
                 CoP         += taxelPos[(*tax)] * out;
@@ -540,7 +567,6 @@ skinContactList Compensator::getContacts(){
                 pressureNormal  += out;
             }
             pressure    += out;
-            taxelList[i] = *tax;
         }
         // if this is not the only contact and no taxel in this contact has a position => discard it
         if(taxelsXcontact.size()>1 && activeTaxelsGeo==0)
@@ -873,28 +899,18 @@ bool Compensator::setTaxelOrientation(unsigned int taxelId, const Vector &orient
     poseSem.post();
     return true;
 }
+void Compensator::buildNeighbors(){
+    allNeighbors = false;
+    neighborsDirty = false;
+    buildTaxelNeighbors(taxelPos, skinDim, maxNeighDist, neighborsStart, neighbors);
+}
+
 void Compensator::computeNeighbors(){
-    neighborsXtaxel.clear();
-    neighborsXtaxel.resize(skinDim, list<int>(0));
-    Vector v;
-    double d2 = maxNeighDist*maxNeighDist;
-    for(unsigned int i=0; i<skinDim; i++){
-        for(unsigned int j=i+1; j<skinDim; j++){
-            //if(taxelPos[i][0]!=0.0 || taxelPos[i][1]!=0.0 || taxelPos[i][2]!=0.0){  // if the taxel exists
-            v = taxelPos[i]-taxelPos[j];
-            if( dot(v,v) <= d2){
-                neighborsXtaxel[i].push_back(j);
-                neighborsXtaxel[j].push_back(i);
-                //printf("Taxels %d (%s) and %d (%s) are neighbors\n", i, taxelPos[i].toString().c_str(), j, taxelPos[j].toString().c_str());
-            }
-            //}
-        }
-    }
+    buildNeighbors();
 
     int minNeighbors=skinDim, maxNeighbors=0, ns;
     for(unsigned int i=0; i<skinDim; i++){
-        //if(taxelPos[i][0]!=0.0 || taxelPos[i][1]!=0.0 || taxelPos[i][2]!=0.0){  // if the taxel exists
-        ns = neighborsXtaxel[i].size();
+        ns = neighborsStart[i+1]-neighborsStart[i];
         if(ns>maxNeighbors) maxNeighbors = ns;
         if(ns<minNeighbors) minNeighbors = ns;
     }
@@ -903,22 +919,9 @@ void Compensator::computeNeighbors(){
     sendInfoMsg(ss.str());
 }
 void Compensator::updateNeighbors(unsigned int taxelId){
-    Vector v;
-    double d2 = maxNeighDist*maxNeighDist;
-    // remove all the neighbors of the taxel with id=taxelId
-    neighborsXtaxel[taxelId].clear();
-
-    for(unsigned int i=0; i<skinDim; i++){
-        //if(taxelPos[i][0]!=0.0 || taxelPos[i][1]!=0.0 || taxelPos[i][2]!=0.0){  // if the taxel exists
-        // remove taxelId from the neighbor list (if there is)
-        neighborsXtaxel[i].remove(taxelId);
-        // check whether they are neighbors
-        v = taxelPos[i]-taxelPos[taxelId];
-        if( dot(v,v) <= d2){
-            neighborsXtaxel[i].push_back(taxelId);
-            neighborsXtaxel[taxelId].push_back(i);
-        }
-    }
+    // the neighbor lists are stored contiguously, so setting the poses one taxel at a time
+    // would rebuild them at each call: defer the rebuild to the next use in getContacts()
+    neighborsDirty = true;
 }
 
 void Compensator::sendInfoMsg(string msg){
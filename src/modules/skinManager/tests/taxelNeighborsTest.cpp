@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Istituto Italiano di Tecnologia - iCub Facility
+ * CopyPolicy: Released under the terms of the GNU GPL v2.0.
+ */
+
+// Compares the voxel grid neighbor lists with a brute-force search over all
+// the taxel pairs, and the union-find contacts with a breadth-first visit of
+// the active taxels, on random skin patches.
+
+#include <cstdio>
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+#include "iCub/skinManager/taxelNeighbors.h"
+
+using namespace std;
+using namespace iCub::skinManager;
+
+namespace{
+    // small deterministic generator, so that failures can be reproduced
+    struct Lcg{
+        unsigned long state;
+        Lcg(unsigned long seed): state(seed){}
+        double uniform(double lo, double hi){
+            state = (state*1103515245UL + 12345UL) & 0x7fffffffUL;
+            return lo + (hi-lo)*(state/2147483648.0);
+        }
+    };
+
+    struct Point{
+        double c[3];
+        double operator[](int k) const{ return c[k]; }
+    };
+
+    vector<unsigned int> bruteForceNeighbors(const vector<Point> &pos, unsigned int i, double maxDist){
+        vector<unsigned int> res;
+        for(unsigned int j=0; j<pos.size(); j++){
+            if(j==i) continue;
+            double dx = pos[i][0]-pos[j][0], dy = pos[i][1]-pos[j][1], dz = pos[i][2]-pos[j][2];
+            if(dx*dx+dy*dy+dz*dz <= maxDist*maxDist)
+                res.push_back(j);
+        }
+        return res;
+    }
+
+    // connected components of the active taxels, numbered in order of their first taxel
+    vector< vector<unsigned int> > bfsContacts(const vector<Point> &pos, const vector<unsigned int> &activeList, double maxDist){
+        vector<bool> active(pos.size(), false), visited(pos.size(), false);
+        for(unsigned int a=0; a<activeList.size(); a++)
+            active[activeList[a]] = true;
+
+        vector< vector<unsigned int> > contacts;
+        vector<int> contactXtaxel(pos.size(), -1);
+        for(unsigned int a=0; a<activeList.size(); a++){
+            unsigned int seed = activeList[a];
+            if(visited[seed]) continue;
+            int id = contacts.size();
+            contacts.resize(id+1);
+            deque<unsigned int> queue(1, seed);
+            visited[seed] = true;
+            while(!queue.empty()){
+                unsigned int i = queue.front();
+                queue.pop_front();
+                contactXtaxel[i] = id;
+                vector<unsigned int> n = bruteForceNeighbors(pos, i, maxDist);
+                for(unsigned int k=0; k<n.size(); k++){
+                    if(active[n[k]] && !visited[n[k]]){
+                        visited[n[k]] = true;
+                        queue.push_back(n[k]);
+                    }
+                }
+            }
+        }
+        // taxels of each contact in the order of the active list
+        for(unsigned int a=0; a<activeList.size(); a++)
+            contacts[contactXtaxel[activeList[a]]].push_back(activeList[a]);
+        return contacts;
+    }
+}
+
+int main(){
+    Lcg rnd(42);
+    int errors = 0;
+    const double maxDists[] = { 0.0, 0.004, 0.011, 0.03 };
+
+    for(int patch=0; patch<20; patch++){
+        // taxels spread on a few square cm, on both sides of the origin so that negative cells are used
+        unsigned int n = 50 + (unsigned int)rnd.uniform(0.0, 300.0);
+        vector<Point> pos(n);
+        for(unsigned int i=0; i<n; i++)
+            for(int k=0; k<3; k++)
+                pos[i].c[k] = rnd.uniform(-0.03, 0.03) * (k==2 ? 0.2 : 1.0);
+        // a duplicated taxel is at distance zero from its twin
+        pos[n-1] = pos[0];
+
+        for(unsigned int d=0; d<sizeof(maxDists)/sizeof(maxDists[0]); d++){
+            double maxDist = maxDists[d];
+            vector<unsigned int> start, neighbors;
+            buildTaxelNeighbors(pos, n, maxDist, start, neighbors);
+
+            for(unsigned int i=0; i<n; i++){
+                vector<unsigned int> grid(neighbors.begin()+start[i], neighbors.begin()+start[i+1]);
+                sort(grid.begin(), grid.end());
+                if(grid != bruteForceNeighbors(pos, i, maxDist)){
+                    fprintf(stderr, "patch %d, maxDist %g: wrong neighbors of taxel %u\n", patch, maxDist, i);
+                    errors++;
+                }
+            }
+
+            vector<int> parent(n, -1), contactXroot(n, -1);
+            for(int round=0; round<5; round++){
+                double density = rnd.uniform(0.05, 0.6);
+                vector<unsigned int> activeList;
+                for(unsigned int i=0; i<n; i++)
+                    if(rnd.uniform(0.0, 1.0) < density)
+                        activeList.push_back(i);
+
+                vector< vector<unsigned int> > contacts;
+                mergeActiveTaxels(activeList, false, start, neighbors, parent);
+                groupActiveTaxels(activeList, parent, contactXroot, contacts);
+
+                if(contacts != bfsContacts(pos, activeList, maxDist)){
+                    fprintf(stderr, "patch %d, maxDist %g, round %d: contacts differ from the breadth-first visit\n",
+                            patch, maxDist, round);
+                    errors++;
+                }
+                // the union-find state must be clean for the next call
+                if(count(parent.begin(), parent.end(), -1) != (int)n || count(contactXroot.begin(), contactXroot.end(), -1) != (int)n){
+                    fprintf(stderr, "patch %d, maxDist %g, round %d: union-find state not reset\n", patch, maxDist, round);
+                    errors++;
+                }
+            }
+        }
+    }
+
+    if(errors==0)
+        printf("voxel grid and union-find agree with brute force and breadth-first search\n");
+    return errors==0 ? 0 : 1;
+}